@@ -0,0 +1,64 @@
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+#include "../src/Polynomial.h"
+#include "../src/Random.h"
+
+using namespace bm;
+
+// Times the three ways to multiply polynomials of n coefficients each, on doubles, next to
+// what multiply() picks, and prints the error of Karatsuba and FFT against the term by term
+// product. The sizes where the columns cross are KaratsubaSize and FFTSize.
+namespace {
+
+	template <typename Multiply>
+	double millisecondsPerCall(Multiply const& multiply) {
+		using Clock = std::chrono::steady_clock;
+		multiply();
+		int calls = 0;
+		Clock::time_point const start = Clock::now();
+		double elapsed = 0.0;
+		do {
+			multiply();
+			++calls;
+			elapsed = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+		} while (elapsed < 100.0);
+		return elapsed / calls;
+	}
+
+	double maxDifference(std::vector<double> const& a, std::vector<double> const& b) {
+		double res = 0.0;
+		for (std::size_t i = 0; i < a.size(); ++i) res = std::max(res, std::abs(a[i] - b[i]));
+		return res;
+	}
+
+}
+
+int main() {
+	namespace internal = _PolynomicFunctionInternal;
+	random::Generator generator(2024);
+	std::printf("%8s %14s %14s %14s %14s %12s %12s\n", "n", "schoolbook ms", "karatsuba ms", "fft ms", "multiply ms", "karatsuba", "fft");
+	for (int n = 8; n <= 8192; n *= 2) {
+		std::vector<double> a(n), b(n), expected(2 * n - 1), res(2 * n - 1), scratch(4 * n + 64);
+		generator.uniform(a.data(), n, -1.0, 1.0);
+		generator.uniform(b.data(), n, -1.0, 1.0);
+		double const schoolbook = millisecondsPerCall([&] { internal::schoolbook(a.data(), n, b.data(), n, expected.data()); });
+		double const karatsuba = millisecondsPerCall([&] { internal::karatsuba(a.data(), b.data(), n, res.data(), scratch.data()); });
+		double const karatsubaError = maxDifference(res, expected);
+		double const fft = millisecondsPerCall([&] { internal::fftMultiply(a.data(), n, b.data(), n, res.data()); });
+		double const fftError = maxDifference(res, expected);
+		double const picked = millisecondsPerCall([&] { internal::multiply(a.data(), n, b.data(), n, res.data()); });
+		std::printf("%8d %14.4f %14.4f %14.4f %14.4f %12.2e %12.2e\n", n, schoolbook, karatsuba, fft, picked, karatsubaError, fftError);
+	}
+
+	// the product of many linear factors, one Polynomial per step, stays on the term by term path
+	std::vector<double> roots(1000);
+	generator.uniform(roots.data(), 1000, -1.0, 1.0);
+	Polynomiald product;
+	double const factors = millisecondsPerCall([&] {
+		product = Polynomiald({ 1.0 });
+		for (double const& root : roots) product = product * Polynomiald({ 1.0, -root });
+	});
+	std::printf("product of %d linear factors: %.2f ms, degree %d\n", static_cast<int>(roots.size()), factors, product.degree());
+}
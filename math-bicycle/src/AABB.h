@@ -0,0 +1,221 @@
+#ifndef _BICYCLE_AABB_H_
+#define _BICYCLE_AABB_H_
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+#include "Point.h"
+#include "Reduction.h"
+#include "Vector.h"
+
+namespace bm {
+
+	namespace _AABBInternal {
+
+		// points gathered per pass, one contiguous array per axis for simd::minMax
+		constexpr int PointBlock = 256;
+
+		// Merges count points into [min, max], the coordinates of point i at coordsOf(i). They are
+		// deinterleaved block by block, so every axis goes through the vectorized min/max; NaNs are
+		// skipped as there.
+		template <int Len, typename T, typename CoordsOf>
+		void merge(int count, CoordsOf const& coordsOf, Point<Len, T>& min, Point<Len, T>& max) {
+			T axes[Len][PointBlock];
+			for (int start = 0; start < count; start += PointBlock) {
+				int const len = std::min(PointBlock, count - start);
+				for (int i = 0; i < len; ++i) {
+					T const* const coords = coordsOf(start + i);
+					for (int d = 0; d < Len; ++d) axes[d][i] = coords[d];
+				}
+				for (int d = 0; d < Len; ++d) {
+					T lo, hi;
+					simd::minMax(axes[d], len, lo, hi);
+					min[d] = lo < min.at(d) ? lo : min.at(d);
+					max[d] = max.at(d) < hi ? hi : max.at(d);
+				}
+			}
+		}
+
+	};
+
+	// Axis-aligned bounding box, the closed set of points between min and max.
+	// A default box is empty: min is above max, so merging anything into it gives that thing.
+	template <int Len, typename T>
+	struct AABB {
+
+		AABB() {
+			for (int d = 0; d < Len; ++d) {
+				min[d] = std::numeric_limits<T>::max();
+				max[d] = std::numeric_limits<T>::lowest();
+			}
+		}
+
+		AABB(Point<Len, T> const& min, Point<Len, T> const& max) : min(min), max(max) { }
+
+		explicit AABB(Point<Len, T> const& point) : min(point), max(point) { }
+
+		AABB(AABB const& other) : min(other.min), max(other.max) { }
+
+		AABB& operator=(AABB const& other) {
+			min = other.min;
+			max = other.max;
+			return *this;
+		}
+
+		static AABB fromPoints(Point<Len, T> const* points, int count) {
+			AABB res;
+			_AABBInternal::merge(count, [points](int i) { return points[i].data(); }, res.min, res.max);
+			return res;
+		}
+
+		// count points of Len interleaved coordinates; a 1D box of a value span needs no gathering
+		static AABB fromCoords(T const* coords, int count) {
+			AABB res;
+			if constexpr (Len == 1) {
+				simd::minMax(coords, count, res.min[0], res.max[0]);
+			}
+			else {
+				_AABBInternal::merge(count, [coords](int i) { return coords + i * Len; }, res.min, res.max);
+			}
+			return res;
+		}
+
+		bool isEmpty() const {
+			for (int d = 0; d < Len; ++d) {
+				if (max.at(d) < min.at(d)) return true;
+			}
+			return false;
+		}
+
+		Vector<Len, T> size() const {
+			return max - min;
+		}
+
+		Point<Len, T> center() const {
+			return min + (max - min) / T(2);
+		}
+
+		bool contains(Point<Len, T> const& point) const {
+			for (int d = 0; d < Len; ++d) {
+				if (point.at(d) < min.at(d) || max.at(d) < point.at(d)) return false;
+			}
+			return true;
+		}
+
+		bool contains(AABB const& other) const {
+			return other.isEmpty() || (contains(other.min) && contains(other.max));
+		}
+
+		bool intersects(AABB const& other) const {
+			return !intersection(other).isEmpty();
+		}
+
+		void expand(Point<Len, T> const& point) {
+			for (int d = 0; d < Len; ++d) {
+				min[d] = std::min(min.at(d), point.at(d));
+				max[d] = std::max(max.at(d), point.at(d));
+			}
+		}
+
+		// smallest box containing both
+		AABB merge(AABB const& other) const {
+			AABB res(*this);
+			for (int d = 0; d < Len; ++d) {
+				res.min[d] = std::min(min.at(d), other.min.at(d));
+				res.max[d] = std::max(max.at(d), other.max.at(d));
+			}
+			return res;
+		}
+
+		// empty when the boxes do not overlap
+		AABB intersection(AABB const& other) const {
+			AABB res(*this);
+			for (int d = 0; d < Len; ++d) {
+				res.min[d] = std::max(min.at(d), other.min.at(d));
+				res.max[d] = std::min(max.at(d), other.max.at(d));
+			}
+			return res;
+		}
+
+		// type of the ray and segment parameters t; integer boxes do the slab math in double
+		using Param = std::conditional_t<std::is_floating_point<T>::value, T, double>;
+
+		// Slab test of origin + t * direction. Narrows [tEnter, tExit] to the part inside the box
+		// and returns false if nothing of it is left.
+		bool clip(Point<Len, T> const& origin, Vector<Len, T> const& direction, Param& tEnter, Param& tExit) const {
+			for (int d = 0; d < Len; ++d) {
+				if (direction.at(d) == T()) {
+					if (origin.at(d) < min.at(d) || max.at(d) < origin.at(d)) return false;
+					continue;
+				}
+				Param const invDirection = Param(1) / Param(direction.at(d));
+				Param t0 = (Param(min.at(d)) - Param(origin.at(d))) * invDirection;
+				Param t1 = (Param(max.at(d)) - Param(origin.at(d))) * invDirection;
+				if (t1 < t0) std::swap(t0, t1);
+				tEnter = std::max(tEnter, t0);
+				tExit = std::min(tExit, t1);
+				if (tExit < tEnter) return false;
+			}
+			return true;
+		}
+
+		// distance along direction to the entry point, 0 when origin is inside
+		bool intersectsRay(Point<Len, T> const& origin, Vector<Len, T> const& direction, Param* distance = nullptr) const {
+			Param tEnter = Param(), tExit = std::numeric_limits<Param>::max();
+			if (!clip(origin, direction, tEnter, tExit)) return false;
+			if (distance) *distance = tEnter;
+			return true;
+		}
+
+		bool intersectsSegment(Point<Len, T> const& from, Point<Len, T> const& to) const {
+			Param tEnter = Param(), tExit = Param(1);
+			return clip(from, to - from, tEnter, tExit);
+		}
+
+		// moves the segment ends onto the box bounds, false if the segment misses the box;
+		// integer ends are rounded to the nearest, which keeps them inside
+		bool clipSegment(Point<Len, T>& from, Point<Len, T>& to) const {
+			Param tEnter = Param(), tExit = Param(1);
+			Vector<Len, T> const direction = to - from;
+			if (!clip(from, direction, tEnter, tExit)) return false;
+			for (int d = 0; d < Len; ++d) {
+				Param const origin = Param(from.at(d)), step = Param(direction.at(d));
+				from[d] = atParam(origin + step * tEnter);
+				to[d] = atParam(origin + step * tExit);
+			}
+			return true;
+		}
+
+		bool operator==(AABB const& other) const {
+			return min == other.min && max == other.max;
+		}
+
+		bool operator!=(AABB const& other) const {
+			return !(*this == other);
+		}
+
+		Point<Len, T> min;
+		Point<Len, T> max;
+
+	private:
+
+		static T atParam(Param coord) {
+			if constexpr (std::is_floating_point<T>::value) return coord;
+			else return static_cast<T>(std::round(coord));
+		}
+
+	};
+
+	using AABB2f = AABB<2, float>;
+	using AABB3f = AABB<3, float>;
+	using AABB2d = AABB<2, double>;
+	using AABB3d = AABB<3, double>;
+	using AABB2i = AABB<2, int>;
+	using AABB3i = AABB<3, int>;
+
+}
+
+#endif // !_BICYCLE_AABB_H_
@@ -0,0 +1,208 @@
+#ifndef _BICYCLE_CHEBYSHEV_H_
+#define _BICYCLE_CHEBYSHEV_H_
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <complex>
+#include <limits>
+#include <vector>
+
+#include "FFT.h"
+#include "Function.h"
+#include "PolynomicFunction.h"
+
+namespace bm {
+
+	namespace _ChebyshevInternal {
+
+		// degrees of the first expansion tried, and the default limit of refinement
+		constexpr int MinDegree = 16;
+		constexpr int MaxDegree = 1 << 16;
+
+		template <typename T>
+		constexpr T pi = T(3.14159265358979323846);
+
+		// point j of the n + 1 Chebyshev points cos(pi * j / n) on [start, end], from end to start;
+		// the sin of the complement is symmetric around the middle, cos itself is not
+		template <typename T>
+		T point(int j, int n, T const& start, T const& end) {
+			T const half = (end - start) / T(2);
+			return start + half + half * std::sin(pi<T> * T(n - 2 * j) / T(2 * n));
+		}
+
+		// Coefficients c_0 .. c_n of the interpolant through values at the points above, a DCT-I
+		// done as the FFT of the even extension of values. n is a power of two.
+		template <typename T>
+		std::vector<T> coefficients(T const* values, int n) {
+			std::vector<std::complex<T>> extension(2 * n);
+			for (int j = 0; j <= n; ++j) extension[j] = values[j];
+			for (int j = 1; j < n; ++j) extension[2 * n - j] = values[j];
+			fft(extension.data(), 2 * n);
+			std::vector<T> res(n + 1);
+			for (int k = 0; k <= n; ++k) res[k] = extension[k].real() / T(n);
+			res[0] /= T(2);
+			res[n] /= T(2);
+			return res;
+		}
+
+	};
+
+	// f(x) = sum c_k T_k(t) on [start, end], with t = (2x - start - end) / (end - start) in [-1, 1]
+	// and T_k the Chebyshev polynomials. Evaluation is Clenshaw's recurrence, O(degree) fmas per
+	// argument; outside [start, end] the sum grows like t^degree.
+	template <typename T>
+	class Chebyshev {
+
+	public:
+
+		Chebyshev(std::vector<T> const& coefficients, T const& start, T const& end)
+			: m_coefficients(coefficients), m_start(start), m_end(end) {
+			assert(!coefficients.empty() && start < end);
+		}
+
+		// the interpolant of values at the n + 1 Chebyshev points of [start, end], n a power of two
+		static Chebyshev interpolant(T const* values, int n, T const& start, T const& end) {
+			return Chebyshev(_ChebyshevInternal::coefficients(values, n), start, end);
+		}
+
+		T operator()(T const& arg) const {
+			T res;
+			evaluate(&arg, &res, 1);
+			return res;
+		}
+
+		// res[i] = (*this)(args[i]); args and res may be the same array. The coefficients are the
+		// outer loop, so the recurrence runs over a whole block of arguments at once.
+		void evaluate(T const* args, T* res, int count) const {
+			using std::fma;
+			int const n = degree();
+			T const* c = m_coefficients.data();
+			T const scale = T(2) / (m_end - m_start), mid = m_start + (m_end - m_start) / T(2);
+			for (int start = 0; start < count; start += EvaluationBlock) {
+				int const len = std::min(EvaluationBlock, count - start);
+				T t[EvaluationBlock], b1[EvaluationBlock], b2[EvaluationBlock];
+				for (int i = 0; i < len; ++i) {
+					t[i] = (args[start + i] - mid) * scale;
+					b1[i] = T();
+					b2[i] = T();
+				}
+				// two steps per pass halve the loads and stores of b1 and b2
+				int k = n;
+				for (; k >= 2; k -= 2) {
+					for (int i = 0; i < len; ++i) {
+						T const twoT = T(2) * t[i];
+						T const first = fma(twoT, b1[i], c[k] - b2[i]);
+						b2[i] = first;
+						b1[i] = fma(twoT, first, c[k - 1] - b1[i]);
+					}
+				}
+				if (k == 1) {
+					for (int i = 0; i < len; ++i) {
+						T const b0 = fma(T(2) * t[i], b1[i], c[1] - b2[i]);
+						b2[i] = b1[i];
+						b1[i] = b0;
+					}
+				}
+				for (int i = 0; i < len; ++i) res[start + i] = fma(t[i], b1[i], c[0] - b2[i]);
+			}
+		}
+
+		int degree() const {
+			return static_cast<int>(m_coefficients.size()) - 1;
+		}
+
+		std::vector<T> const& coefficients() const {
+			return m_coefficients;
+		}
+
+		T start() const {
+			return m_start;
+		}
+
+		T end() const {
+			return m_end;
+		}
+
+		// The same polynomial in powers of x, for a degree up to N. The monomial basis is badly
+		// conditioned on wide or off-center intervals, so this is for small degrees only.
+		template <int N>
+		PolynomicFunction<N, T> toPolynomic() const {
+			assert(degree() <= N);
+			T const scale = T(2) / (m_end - m_start), shift = -(m_start + m_end) / (m_end - m_start);
+			// T_k(t(x)) in powers of x from the constant up, through T_k+1 = 2 t T_k - T_k-1
+			T previous[N + 1] = { T(1) }, current[N + 1] = { shift }, sum[N + 1] = { m_coefficients[0] };
+			if constexpr (N > 0) current[1] = scale;
+			for (int k = 1; k <= degree(); ++k) {
+				for (int i = 0; i <= N; ++i) sum[i] += m_coefficients[k] * current[i];
+				T next[N + 1];
+				for (int i = 0; i <= N; ++i) {
+					next[i] = T(2) * shift * current[i] - previous[i];
+					if (i > 0) next[i] += T(2) * scale * current[i - 1];
+				}
+				std::copy(current, current + N + 1, previous);
+				std::copy(next, next + N + 1, current);
+			}
+			T coefficients[N + 1];
+			for (int i = 0; i <= N; ++i) coefficients[i] = sum[N - i];
+			return PolynomicFunction<N, T>(coefficients);
+		}
+
+	private:
+
+		std::vector<T> m_coefficients;
+		T m_start;
+		T m_end;
+
+	};
+
+	// Chebyshev expansion of func on [start, end] to machine precision. Interpolants of degree
+	// 16, 32, ... are built from func at Chebyshev points (each one reusing the points of the
+	// last) until the last eighth of the coefficients falls to the rounding noise of the values;
+	// the coefficients below that noise are then cut from the end. Functions with a kink or a
+	// pole nearby stop at maxDegree instead, with converged (when given) set to false.
+	template <typename Func, typename T>
+	Chebyshev<T> chebyshev(
+		Func const& func, T const& start, T const& end,
+		int maxDegree = _ChebyshevInternal::MaxDegree, bool* converged = nullptr
+	) {
+		assert(start < end);
+		using _ChebyshevInternal::point;
+		int n = _ChebyshevInternal::MinDegree;
+		std::vector<T> points(n + 1), values(n + 1);
+		for (int j = 0; j <= n; ++j) points[j] = point(j, n, start, end);
+		_FunctionInternal::sample(func, points.data(), values.data(), n + 1);
+
+		for (;;) {
+			std::vector<T> coefficients = _ChebyshevInternal::coefficients(values.data(), n);
+			T scale = T();
+			for (T const& value : values) scale = std::max(scale, std::abs(value));
+			// the rounding of the values and of the transform, which grows slowly with n
+			T const noise = T(2) * std::log2(T(n)) * std::numeric_limits<T>::epsilon() * scale;
+			bool tailIsNoise = true;
+			for (int k = n - n / 8; k <= n; ++k) tailIsNoise = tailIsNoise && std::abs(coefficients[k]) <= noise;
+			if (tailIsNoise || 2 * n > maxDegree) {
+				if (converged) *converged = tailIsNoise;
+				if (tailIsNoise) {
+					int last = n;
+					while (last > 0 && std::abs(coefficients[last]) <= noise) --last;
+					coefficients.resize(last + 1);
+				}
+				return Chebyshev<T>(coefficients, start, end);
+			}
+
+			// the new points fall between the old ones
+			std::vector<T> newPoints(n), newValues(n);
+			for (int j = 0; j < n; ++j) newPoints[j] = point(2 * j + 1, 2 * n, start, end);
+			_FunctionInternal::sample(func, newPoints.data(), newValues.data(), n);
+			std::vector<T> merged(2 * n + 1);
+			for (int j = 0; j <= n; ++j) merged[2 * j] = values[j];
+			for (int j = 0; j < n; ++j) merged[2 * j + 1] = newValues[j];
+			values.swap(merged);
+			n *= 2;
+		}
+	}
+
+}
+
+#endif // !_BICYCLE_CHEBYSHEV_H_
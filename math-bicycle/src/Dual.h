@@ -0,0 +1,234 @@
+#ifndef _BICYCLE_DUAL_H_
+#define _BICYCLE_DUAL_H_
+
+#include <cmath>
+#include <type_traits>
+
+#include "Simd.h"
+
+namespace bm {
+
+	namespace _DualInternal {
+
+		// keeps a parameter out of template argument deduction, so Dual<double> * 2 finds the scalar overload
+		template <typename T>
+		struct Identity {
+			using type = T;
+		};
+
+		template <typename T>
+		using NonDeduced = typename Identity<T>::type;
+
+	};
+
+	// Forward mode automatic differentiation: a value together with its partial derivatives
+	// by N independent variables. Arithmetic and the math functions below apply the chain rule,
+	// so one evaluation of any template over T gives the value and all N partials.
+	// Math functions are found by argument dependent lookup: generic code calls them as
+	// `using std::sin; sin(x)`. T may be a Dual itself for higher derivatives.
+	template <typename T, int N = 1>
+	struct Dual {
+
+		static_assert(N > 0, "Dual needs at least one partial derivative.");
+
+		constexpr Dual() : value(), d{} { }
+
+		// constants have zero partials
+		constexpr Dual(T const& value) : value(value), d{} { }
+
+		// the variable with the given index: its own partial is one
+		static Dual variable(T const& value, int index = 0) {
+			Dual res(value);
+			res.d[index] = T(1);
+			return res;
+		}
+
+		explicit operator bool() const {
+			return value != T();
+		}
+
+		Dual operator-() const {
+			Dual res(-value);
+			for (int i = 0; i < N; ++i) res.d[i] = -d[i];
+			return res;
+		}
+
+		Dual operator+() const {
+			return *this;
+		}
+
+		Dual& operator+=(Dual const& other) {
+			value += other.value;
+			for (int i = 0; i < N; ++i) d[i] += other.d[i];
+			return *this;
+		}
+
+		Dual& operator-=(Dual const& other) {
+			value -= other.value;
+			for (int i = 0; i < N; ++i) d[i] -= other.d[i];
+			return *this;
+		}
+
+		Dual& operator*=(Dual const& other) {
+			for (int i = 0; i < N; ++i) d[i] = d[i] * other.value + value * other.d[i];
+			value *= other.value;
+			return *this;
+		}
+
+		Dual& operator/=(Dual const& other) {
+			T const inv = T(1) / other.value;
+			value *= inv;
+			for (int i = 0; i < N; ++i) d[i] = (d[i] - value * other.d[i]) * inv;
+			return *this;
+		}
+
+		Dual& operator+=(T const& other) {
+			value += other;
+			return *this;
+		}
+
+		Dual& operator-=(T const& other) {
+			value -= other;
+			return *this;
+		}
+
+		Dual& operator*=(T const& other) {
+			value *= other;
+			for (int i = 0; i < N; ++i) d[i] *= other;
+			return *this;
+		}
+
+		Dual& operator/=(T const& other) {
+			T const inv = T(1) / other;
+			value *= inv;
+			for (int i = 0; i < N; ++i) d[i] *= inv;
+			return *this;
+		}
+
+		T value;
+		T d[N];
+
+	};
+
+	#define DUAL_BINARY_OPERATOR(OP) \
+	template <typename T, int N> \
+	Dual<T, N> operator OP(Dual<T, N> left, Dual<T, N> const& right) { return left OP##= right; } \
+	template <typename T, int N> \
+	Dual<T, N> operator OP(Dual<T, N> left, _DualInternal::NonDeduced<T> const& right) { return left OP##= right; } \
+	template <typename T, int N> \
+	Dual<T, N> operator OP(_DualInternal::NonDeduced<T> const& left, Dual<T, N> const& right) { return Dual<T, N>(left) OP##= right; }
+
+	DUAL_BINARY_OPERATOR(+)
+	DUAL_BINARY_OPERATOR(-)
+	DUAL_BINARY_OPERATOR(/)
+
+	#undef DUAL_BINARY_OPERATOR
+
+	template <typename T, int N>
+	Dual<T, N> operator*(Dual<T, N> left, Dual<T, N> const& right) {
+		return left *= right;
+	}
+
+	template <typename T, int N>
+	Dual<T, N> operator*(Dual<T, N> left, _DualInternal::NonDeduced<T> const& right) {
+		return left *= right;
+	}
+
+	template <typename T, int N>
+	Dual<T, N> operator*(_DualInternal::NonDeduced<T> const& left, Dual<T, N> right) {
+		return right *= left;
+	}
+
+	// comparisons look at values only, so branches in generic code take the same path as with T
+	#define DUAL_COMPARISON_OPERATOR(OP) \
+	template <typename T, int N> \
+	bool operator OP(Dual<T, N> const& left, Dual<T, N> const& right) { return left.value OP right.value; } \
+	template <typename T, int N> \
+	bool operator OP(Dual<T, N> const& left, _DualInternal::NonDeduced<T> const& right) { return left.value OP right; } \
+	template <typename T, int N> \
+	bool operator OP(_DualInternal::NonDeduced<T> const& left, Dual<T, N> const& right) { return left OP right.value; }
+
+	DUAL_COMPARISON_OPERATOR(==)
+	DUAL_COMPARISON_OPERATOR(!=)
+	DUAL_COMPARISON_OPERATOR(<)
+	DUAL_COMPARISON_OPERATOR(<=)
+	DUAL_COMPARISON_OPERATOR(>)
+	DUAL_COMPARISON_OPERATOR(>=)
+
+	#undef DUAL_COMPARISON_OPERATOR
+
+	namespace _DualInternal {
+
+		// f(x) with f'(x) = derivative
+		template <typename T, int N>
+		Dual<T, N> chain(Dual<T, N> const& x, T const& value, T const& derivative) {
+			Dual<T, N> res(value);
+			for (int i = 0; i < N; ++i) res.d[i] = derivative * x.d[i];
+			return res;
+		}
+
+	};
+
+	#define DUAL_FUNC(FUNC, VALUE, DERIVATIVE) \
+	template <typename T, int N> \
+	Dual<T, N> FUNC(Dual<T, N> const& x) { \
+		using std::sin; using std::cos; using std::tan; using std::exp; using std::log; using std::log10; using std::sqrt; \
+		using std::sinh; using std::cosh; using std::tanh; using std::atan; using std::abs; \
+		T const& v = x.value; \
+		T const value = VALUE; \
+		return _DualInternal::chain(x, value, T(DERIVATIVE)); \
+	}
+
+	DUAL_FUNC(sin, sin(v), cos(v))
+	DUAL_FUNC(cos, cos(v), -sin(v))
+	DUAL_FUNC(tan, tan(v), T(1) + value * value)
+	DUAL_FUNC(exp, exp(v), value)
+	DUAL_FUNC(log, log(v), T(1) / v)
+	DUAL_FUNC(log10, log10(v), T(1) / (v * log(T(10))))
+	DUAL_FUNC(sqrt, sqrt(v), T(0.5) / value)
+	DUAL_FUNC(sinh, sinh(v), cosh(v))
+	DUAL_FUNC(cosh, cosh(v), sinh(v))
+	DUAL_FUNC(tanh, tanh(v), T(1) - value * value)
+	DUAL_FUNC(atan, atan(v), T(1) / (T(1) + v * v))
+	// the derivative at 0 is taken as 0
+	DUAL_FUNC(abs, abs(v), v > T() ? T(1) : v < T() ? T(-1) : T())
+	DUAL_FUNC(fabs, abs(v), v > T() ? T(1) : v < T() ? T(-1) : T())
+
+	#undef DUAL_FUNC
+
+	template <typename T, int N>
+	Dual<T, N> pow(Dual<T, N> const& x, _DualInternal::NonDeduced<T> const& power) {
+		using std::pow;
+		T const value = pow(x.value, power);
+		return _DualInternal::chain(x, value, T(power * pow(x.value, power - T(1))));
+	}
+
+	template <typename T, int N>
+	Dual<T, N> pow(Dual<T, N> const& x, Dual<T, N> const& power) {
+		return exp(power * log(x));
+	}
+
+	// a * b + c; fma of the values keeps the value bitwise equal to the one computed on T
+	template <typename T, int N>
+	Dual<T, N> fma(Dual<T, N> const& a, Dual<T, N> const& b, Dual<T, N> const& c) {
+		using std::fma;
+		Dual<T, N> res(fma(a.value, b.value, c.value));
+		for (int i = 0; i < N; ++i) res.d[i] = fma(a.d[i], b.value, fma(a.value, b.d[i], c.d[i]));
+		return res;
+	}
+
+	template <typename T, int N>
+	struct ScalarTraits<Dual<T, N>> {
+
+		static constexpr bool isNumber = ScalarTraits<T>::isNumber;
+
+		using Compute = Dual<T, N>;
+
+	};
+
+	using Dualf = Dual<float>;
+	using Duald = Dual<double>;
+
+}
+
+#endif // !_BICYCLE_DUAL_H_
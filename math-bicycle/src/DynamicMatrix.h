@@ -0,0 +1,286 @@
+#ifndef _BICYCLE_DYNAMIC_MATRIX_H_
+#define _BICYCLE_DYNAMIC_MATRIX_H_
+
+#include <algorithm>
+#include <cassert>
+#include <initializer_list>
+#include <type_traits>
+#include <vector>
+
+#include "Parallel.h"
+#include "Simd.h"
+#include "Matrix.h"
+#include "DynamicVector.h"
+
+namespace bm {
+
+	// Runtime length counterpart of Row. Operations run over the padded stride of the owning matrix.
+	template <typename T>
+	class DynamicRow {
+
+		static constexpr std::size_t Alignment = simd::Layout<std::remove_const_t<T>>::alignment;
+
+	public:
+		DynamicRow(T* row_data, int len, int stride) : m_row_data(row_data), m_len(len), m_stride(stride) { }
+
+		T& operator[](int i) {
+			assert(i >= 0 && i < m_len);
+			return m_row_data[i];
+		}
+
+		T const& at(int i) const {
+			assert(i >= 0 && i < m_len);
+			return m_row_data[i];
+		}
+
+		T* data() const {
+			return m_row_data;
+		}
+
+		int size() const {
+			return m_len;
+		}
+
+		void fill(T const& value) {
+			simd::fill<Alignment>(m_row_data, value, m_len);
+		}
+
+		void scale(T const& s, bool multiply = true) {
+			if (multiply) simd::scal<Alignment>(m_row_data, s, m_stride);
+			else simd::invScal<Alignment>(m_row_data, s, m_stride);
+		}
+
+		template <typename OtherT>
+		void add(DynamicRow<OtherT> const& row) {
+			assert(row.size() == m_len);
+			simd::add<Alignment>(m_row_data, row.data(), m_stride);
+		}
+
+		template <typename OtherT>
+		void addScaled(DynamicRow<OtherT> const& row, T const& s, bool multiply = true) {
+			assert(row.size() == m_len);
+			if (multiply) simd::axpy<Alignment>(m_row_data, row.data(), s, m_stride);
+			else simd::invAxpy<Alignment>(m_row_data, row.data(), s, m_stride);
+		}
+
+		void swap(DynamicRow other) {
+			assert(other.size() == m_len);
+			simd::swap<Alignment>(m_row_data, other.data(), m_stride);
+		}
+
+	private:
+		T* m_row_data;
+		int m_len;
+		int m_stride;
+	};
+
+	// Matrix with dimensions known only at runtime. Storage is row-major with the same padded,
+	// aligned row layout as Matrix, so both share the row kernels and elimination routines.
+	template <typename T>
+	struct DynamicMatrix {
+
+		using Layout = simd::Layout<T>;
+
+		// like Matrix, a default square matrix of a number type is the identity
+		DynamicMatrix(int rows, int cols)
+			: m_rows(rows), m_cols(cols), m_stride(Layout::stride(cols)), m_vals(rows * Layout::stride(cols), T()) {
+			assert(rows > 0 && cols > 0);
+			if constexpr (ScalarTraits<T>::isNumber) {
+				if (rows == cols) {
+					for (int i = 0; i < rows; ++i) at(i, i) = static_cast<T>(1);
+				}
+			}
+		}
+
+		DynamicMatrix(int rows, int cols, T const* data) : DynamicMatrix(rows, cols) {
+			for (int i = 0; i < m_rows; ++i) {
+				for (int j = 0; j < m_cols; ++j) {
+					at(i, j) = T(data[i * m_cols + j]);
+				}
+			}
+		}
+
+		DynamicMatrix(int rows, int cols, std::initializer_list<T> data) : DynamicMatrix(rows, cols, data.begin()) {
+			assert(static_cast<int>(data.size()) == rows * cols);
+		}
+
+		template <int Rows, int Cols>
+		explicit DynamicMatrix(Matrix<Rows, Cols, T> const& mat) : DynamicMatrix(Rows, Cols) {
+			for (int i = 0; i < Rows; ++i) {
+				for (int j = 0; j < Cols; ++j) {
+					at(i, j) = mat.at(i, j);
+				}
+			}
+		}
+
+		template <int Rows, int Cols>
+		Matrix<Rows, Cols, T> toMatrix() const {
+			assert(m_rows == Rows && m_cols == Cols);
+			Matrix<Rows, Cols, T> resMat;
+			for (int i = 0; i < Rows; ++i) {
+				for (int j = 0; j < Cols; ++j) {
+					resMat.at(i, j) = at(i, j);
+				}
+			}
+			return resMat;
+		}
+
+		int rows() const {
+			return m_rows;
+		}
+
+		int cols() const {
+			return m_cols;
+		}
+
+		int stride() const {
+			return m_stride;
+		}
+
+		DynamicRow<T> operator[](int i) {
+			return row(i);
+		}
+
+		DynamicRow<const T> const at(int i) const {
+			return row(i);
+		}
+
+		DynamicRow<T> row(int i) {
+			assert(i >= 0 && i < m_rows);
+			return DynamicRow<T>(m_vals.data() + i * m_stride, m_cols, m_stride);
+		}
+
+		DynamicRow<const T> row(int i) const {
+			assert(i >= 0 && i < m_rows);
+			return DynamicRow<const T>(m_vals.data() + i * m_stride, m_cols, m_stride);
+		}
+
+		T& at(int i, int j) {
+			assert(i >= 0 && i < m_rows && j >= 0 && j < m_cols);
+			return m_vals[i * m_stride + j];
+		}
+
+		T const& at(int i, int j) const {
+			assert(i >= 0 && i < m_rows && j >= 0 && j < m_cols);
+			return m_vals[i * m_stride + j];
+		}
+
+		DynamicMatrix trans() const {
+			DynamicMatrix resMat(m_cols, m_rows);
+			for (int i = 0; i < m_rows; ++i) {
+				for (int j = 0; j < m_cols; ++j) {
+					resMat.at(j, i) = at(i, j);
+				}
+			}
+			return resMat;
+		}
+
+		// i-k-j order: every result row is accumulated with axpy over whole rows of other.
+		// Large products split rows between threads; each element still sums its products in ascending k,
+		// so the result does not depend on the number of threads.
+		DynamicMatrix operator*(DynamicMatrix const& other) const {
+			assert(m_cols == other.m_rows);
+			DynamicMatrix resMat(m_rows, other.m_cols);
+			int const rowWork = std::max(1, m_cols * other.m_cols);
+			parallel::forRange(m_rows, parallel::MinWorkPerThread / rowWork, [this, &other, &resMat](int begin, int end) {
+				for (int i = begin; i < end; ++i) {
+					auto resRow = resMat[i];
+					resRow.fill(T());
+					for (int k = 0; k < m_cols; ++k) {
+						resRow.addScaled(other.at(k), at(i, k));
+					}
+				}
+			});
+			return resMat;
+		}
+
+		DynamicMatrix operator+(DynamicMatrix const& other) const {
+			assert(m_rows == other.m_rows && m_cols == other.m_cols);
+			DynamicMatrix resMat(*this);
+			for (int i = 0; i < m_rows; ++i) { resMat[i].add(other.at(i)); }
+			return resMat;
+		}
+
+		DynamicMatrix operator-(DynamicMatrix const& other) const {
+			assert(m_rows == other.m_rows && m_cols == other.m_cols);
+			DynamicMatrix resMat(*this);
+			for (int i = 0; i < m_rows; ++i) { resMat[i].addScaled(other.at(i), T(-1)); }
+			return resMat;
+		}
+
+		DynamicMatrix operator*(T scale) const {
+			DynamicMatrix resMat(*this);
+			for (int i = 0; i < m_rows; ++i) { resMat[i].scale(scale); }
+			return resMat;
+		}
+
+		DynamicMatrix operator/(T scale) const {
+			DynamicMatrix resMat(*this);
+			for (int i = 0; i < m_rows; ++i) { resMat[i].scale(scale, false); }
+			return resMat;
+		}
+
+		template <int InlineCapacity>
+		DynamicVector<T, InlineCapacity> operator*(DynamicVector<T, InlineCapacity> const& vec) const {
+			assert(m_cols == vec.size());
+			DynamicVector<T, InlineCapacity> resVec(m_rows);
+			for (int i = 0; i < m_rows; ++i) {
+				resVec[i] = at(i, 0) * vec.at(0);
+				for (int j = 1; j < m_cols; ++j) {
+					resVec[i] = resVec[i] + at(i, j) * vec.at(j);
+				}
+			}
+			return resVec;
+		}
+
+		DynamicMatrix inv() const {
+			assert(m_rows == m_cols);
+			DynamicMatrix identity(m_rows, m_cols), this_copy(*this);
+			_MatrixInternal::invert<T>(this_copy, identity, m_rows);
+			return identity;
+		}
+
+		T det() const {
+			assert(m_rows == m_cols);
+			DynamicMatrix this_copy(*this);
+			return _MatrixInternal::determinant<T>(this_copy, m_rows);
+		}
+
+	private:
+
+		int m_rows;
+		int m_cols;
+		int m_stride;
+		std::vector<T, simd::AlignedAllocator<T>> m_vals;
+
+	};
+
+	template <typename T>
+	bool equals(DynamicMatrix<T> const& mat1, DynamicMatrix<T> const& mat2, T const& delta = T()) {
+		if (&mat1 == &mat2)
+			return true;
+
+		if (mat1.rows() != mat2.rows() || mat1.cols() != mat2.cols())
+			return false;
+
+		for (int i = 0; i < mat1.rows(); ++i) {
+			for (int j = 0; j < mat1.cols(); ++j) {
+				T const& mat1ij = mat1.at(i, j);
+				T const& mat2ij = mat2.at(i, j);
+				if (
+					!(mat1ij <= mat2ij + delta && mat2ij <= mat1ij + delta) &&
+					!(mat2ij <= mat1ij + delta && mat1ij <= mat2ij + delta)) {
+					return false;
+				}
+			}
+		}
+
+		return true;
+	}
+
+	using DynamicMatrixf = DynamicMatrix<float>;
+	using DynamicMatrixd = DynamicMatrix<double>;
+	using DynamicMatrixi = DynamicMatrix<int>;
+}
+
+#endif // !_BICYCLE_DYNAMIC_MATRIX_H_
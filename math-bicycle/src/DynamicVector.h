@@ -0,0 +1,230 @@
+#ifndef _BICYCLE_DYNAMIC_VECTOR_H_
+#define _BICYCLE_DYNAMIC_VECTOR_H_
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <initializer_list>
+#include <vector>
+
+#include "Reduction.h"
+#include "Simd.h"
+#include "Vector.h"
+
+namespace bm {
+
+	#define BINARY_OPERATOR(OP, OTHER_T, OTHER_ACCES) \
+	DynamicVector operator OP(OTHER_T const& other) const { \
+		assert(hasSameSize(other)); \
+		DynamicVector res(m_size); \
+		for (int i = 0; i < m_size; ++i) { \
+			res.m_vals[i] = m_vals[i] OP other OTHER_ACCES; \
+		} \
+		return res; \
+	}
+
+	// Vector whose length is known only at runtime. Up to InlineCapacity elements live inside
+	// the object itself, so small vectors never touch the heap; longer ones spill to aligned heap storage.
+	template <typename T, int InlineCapacity = 16>
+	struct DynamicVector {
+
+		template <typename T2, int InlineCapacity2>
+		friend struct DynamicVector;
+
+		DynamicVector() : m_size(0), m_vals(m_inline) { }
+
+		explicit DynamicVector(int size, T const& initValue = T()) : DynamicVector() {
+			allocate(size);
+			std::fill(m_vals, m_vals + m_size, initValue);
+		}
+
+		DynamicVector(T const* data, int size) : DynamicVector() {
+			allocate(size);
+			std::copy(data, data + size, m_vals);
+		}
+
+		DynamicVector(std::initializer_list<T> data) : DynamicVector(data.begin(), static_cast<int>(data.size())) { }
+
+		template <int Len>
+		explicit DynamicVector(Vector<Len, T> const& vec) : DynamicVector() {
+			allocate(Len);
+			for (int i = 0; i < Len; ++i) { m_vals[i] = vec.at(i); }
+		}
+
+		DynamicVector(DynamicVector const& other) : DynamicVector(other.m_vals, other.m_size) { }
+
+		DynamicVector(DynamicVector&& other) : DynamicVector() {
+			*this = std::move(other);
+		}
+
+		DynamicVector& operator=(DynamicVector const& other) {
+			if (this != &other) {
+				allocate(other.m_size);
+				std::copy(other.m_vals, other.m_vals + m_size, m_vals);
+			}
+			return *this;
+		}
+
+		DynamicVector& operator=(DynamicVector&& other) {
+			if (this == &other) return *this;
+			if (other.isInline()) {
+				*this = other;
+			}
+			else {
+				m_heap = std::move(other.m_heap);
+				m_size = other.m_size;
+				m_vals = m_heap.data();
+			}
+			other.m_heap.clear();
+			other.m_size = 0;
+			other.m_vals = other.m_inline;
+			return *this;
+		}
+
+		BINARY_OPERATOR(+, DynamicVector, .m_vals[i]);
+		BINARY_OPERATOR(-, DynamicVector, .m_vals[i]);
+		BINARY_OPERATOR(*, DynamicVector, .m_vals[i]);
+		BINARY_OPERATOR(/, DynamicVector, .m_vals[i]);
+		BINARY_OPERATOR(/, T, );
+		BINARY_OPERATOR(*, T, );
+		BINARY_OPERATOR(+, T, );
+		BINARY_OPERATOR(-, T, );
+
+		int size() const {
+			return m_size;
+		}
+
+		// keeps the first min(size, newSize) elements, new ones are value initialized
+		void resize(int newSize) {
+			DynamicVector resized(newSize);
+			std::copy(m_vals, m_vals + std::min(m_size, newSize), resized.m_vals);
+			*this = std::move(resized);
+		}
+
+		T* data() {
+			return m_vals;
+		}
+
+		T const* data() const {
+			return m_vals;
+		}
+
+		T* begin() { return m_vals; }
+		T* end() { return m_vals + m_size; }
+		T const* begin() const { return m_vals; }
+		T const* end() const { return m_vals + m_size; }
+
+		T const& at(int index) const {
+			assert(index >= 0 && index < m_size);
+			return m_vals[index];
+		}
+
+		T& operator[](int index) {
+			assert(index >= 0 && index < m_size);
+			return m_vals[index];
+		}
+
+		template <int Len>
+		Vector<Len, T> toVector() const {
+			assert(m_size == Len);
+			Vector<Len, T> res;
+			for (int i = 0; i < Len; ++i) { res[i] = m_vals[i]; }
+			return res;
+		}
+
+		// long vectors lose accuracy with Sequential, see Reduction for the alternatives
+		template <Reduction Mode = Reduction::Sequential>
+		T dot(DynamicVector const& other) const {
+			assert(hasSameSize(other));
+			return simd::dot<Mode>(m_vals, other.m_vals, m_size);
+		}
+
+		template <Reduction Mode = Reduction::Sequential>
+		auto norm() const {
+			return simd::norm<Mode>(m_vals, m_size);
+		}
+
+		bool operator==(DynamicVector const& other) const {
+			return m_size == other.m_size && std::equal(m_vals, m_vals + m_size, other.m_vals);
+		}
+
+		bool operator!=(DynamicVector const& other) const {
+			return !(*this == other);
+		}
+
+	private:
+
+		bool hasSameSize(DynamicVector const& other) const {
+			return m_size == other.m_size;
+		}
+
+		bool hasSameSize(T const&) const {
+			return true;
+		}
+
+		bool isInline() const {
+			return m_vals == m_inline;
+		}
+
+		// contents are unspecified after the call
+		void allocate(int size) {
+			assert(size >= 0);
+			m_size = size;
+			if (size <= InlineCapacity) {
+				m_heap.clear();
+				m_vals = m_inline;
+			}
+			else {
+				m_heap.resize(size);
+				m_vals = m_heap.data();
+			}
+		}
+
+		int m_size;
+		std::vector<T, simd::AlignedAllocator<T>> m_heap;
+		alignas(simd::Layout<T>::alignment) T m_inline[InlineCapacity] = { T() };
+		T* m_vals;
+
+	};
+
+	template <typename T, int InlineCapacity>
+	DynamicVector<T, InlineCapacity> operator*(T const& scale, DynamicVector<T, InlineCapacity> const& vec) {
+		return vec * scale;
+	}
+
+	template <typename T, int InlineCapacity>
+	bool equals(DynamicVector<T, InlineCapacity> const& vec1, DynamicVector<T, InlineCapacity> const& vec2, T delta = T()) {
+		if (&vec1 == &vec2)
+			return true;
+
+		if (vec1.size() != vec2.size())
+			return false;
+
+		for (int i = 0; i < vec1.size(); ++i) {
+			T const& vec1i = vec1.at(i);
+			T const& vec2i = vec2.at(i);
+			if (
+				!(vec1i <= vec2i + delta && vec2i <= vec1i + delta) &&
+				!(vec2i <= vec1i + delta && vec1i <= vec2i + delta)) {
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	template <typename ToType, typename FromType, int InlineCapacity>
+	DynamicVector<ToType, InlineCapacity> changeT(DynamicVector<FromType, InlineCapacity> const& fromVec) {
+		DynamicVector<ToType, InlineCapacity> res(fromVec.size());
+		for (int i = 0; i < fromVec.size(); ++i) res[i] = ToType(fromVec.at(i));
+		return res;
+	}
+
+	using DynamicVectorf = DynamicVector<float>;
+	using DynamicVectord = DynamicVector<double>;
+	using DynamicVectori = DynamicVector<int>;
+
+	#undef BINARY_OPERATOR
+};
+
+#endif // !_BICYCLE_DYNAMIC_VECTOR_H_
@@ -0,0 +1,67 @@
+#ifndef _BICYCLE_FFT_H_
+#define _BICYCLE_FFT_H_
+
+#include <cassert>
+#include <cmath>
+#include <complex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace bm {
+
+	namespace _FFTInternal {
+
+		template <typename T>
+		constexpr T pi = T(3.14159265358979323846);
+
+		// e^(-2 pi i j / n) for j < n / 2, each from its own sin and cos so the error does not grow with j
+		template <typename T>
+		std::vector<std::complex<T>> roots(int n) {
+			std::vector<std::complex<T>> res(n / 2);
+			for (int j = 0; j < n / 2; ++j) {
+				T const angle = T(2) * pi<T> * T(j) / T(n);
+				res[j] = std::complex<T>(std::cos(angle), -std::sin(angle));
+			}
+			return res;
+		}
+
+	};
+
+	// In place discrete Fourier transform of n = 2^k values, y_k = sum_j x_j e^(-2 pi i j k / n),
+	// by iterative radix-2 Cooley-Tukey. The inverse uses e^(+2 pi i j k / n) and divides by n,
+	// so it undoes the forward transform.
+	template <typename T>
+	void fft(std::complex<T>* data, int n, bool inverse = false) {
+		static_assert(std::is_floating_point<T>::value, "fft needs a floating point type.");
+		assert(n > 0 && (n & (n - 1)) == 0);
+
+		for (int i = 1, j = 0; i < n; ++i) {
+			int bit = n >> 1;
+			for (; j & bit; bit >>= 1) j ^= bit;
+			j ^= bit;
+			if (i < j) std::swap(data[i], data[j]);
+		}
+
+		std::vector<std::complex<T>> const roots = _FFTInternal::roots<T>(n);
+		for (int len = 2; len <= n; len <<= 1) {
+			int const half = len >> 1, step = n / len;
+			for (int start = 0; start < n; start += len) {
+				for (int j = 0; j < half; ++j) {
+					std::complex<T> const root = roots[j * step], value = data[start + j + half];
+					T const rootImag = inverse ? -root.imag() : root.imag();
+					// spelled out, as std::complex products check for infinities and NaNs
+					std::complex<T> const even = data[start + j];
+					std::complex<T> const odd(value.real() * root.real() - value.imag() * rootImag, value.real() * rootImag + value.imag() * root.real());
+					data[start + j] = even + odd;
+					data[start + j + half] = even - odd;
+				}
+			}
+		}
+
+		if (inverse) for (int i = 0; i < n; ++i) data[i] /= T(n);
+	}
+
+}
+
+#endif // !_BICYCLE_FFT_H_
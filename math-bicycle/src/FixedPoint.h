@@ -0,0 +1,100 @@
+#ifndef _BICYCLE_FIXED_POINT_H_
+#define _BICYCLE_FIXED_POINT_H_
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#include "Simd.h"
+
+namespace bm {
+
+	// Signed fixed point number raw / 2^FracBits stored in Int. Like half it converts implicitly
+	// to and from its Compute type (float while that holds every value exactly, double otherwise),
+	// expressions are computed there and only the stored result is rounded.
+	// Conversion rounds to nearest and saturates at the range of Int, NaN becomes the lowest value.
+	template <int FracBits, typename Int = std::int32_t>
+	struct FixedPoint {
+
+		static_assert(std::is_integral<Int>::value && std::is_signed<Int>::value, "FixedPoint is stored in a signed integer type.");
+		static_assert(sizeof(Int) <= 4, "Integers wider than 32 bits do not fit the double compute type.");
+		static_assert(FracBits >= 0 && FracBits < std::numeric_limits<Int>::digits, "FracBits should leave room for the sign.");
+
+		using Compute = std::conditional_t<(std::numeric_limits<Int>::digits < std::numeric_limits<float>::digits), float, double>;
+
+		static constexpr Compute scale = Compute(std::int64_t(1) << FracBits);
+
+		constexpr FixedPoint() : raw(0) { }
+
+		FixedPoint(Compute value) : raw(encode(value)) { }
+
+		operator Compute() const {
+			return Compute(raw) * (Compute(1) / scale);
+		}
+
+		FixedPoint& operator+=(Compute other) { return *this = *this + other; }
+		FixedPoint& operator-=(Compute other) { return *this = *this - other; }
+		FixedPoint& operator*=(Compute other) { return *this = *this * other; }
+		FixedPoint& operator/=(Compute other) { return *this = *this / other; }
+
+		static constexpr FixedPoint fromRaw(Int raw) {
+			FixedPoint res;
+			res.raw = raw;
+			return res;
+		}
+
+		// branch free, so loops over it vectorize
+		static Int encode(Compute value) {
+			Compute const lowest = Compute(std::numeric_limits<Int>::lowest());
+			Compute const highest = Compute(std::numeric_limits<Int>::max());
+			// std::max(lowest, NaN) is lowest
+			Compute const scaled = std::min(std::max(lowest, value * scale), highest);
+			return static_cast<Int>(std::nearbyint(scaled));
+		}
+
+		Int raw;
+
+	};
+
+	template <int FracBits, typename Int>
+	struct ScalarTraits<FixedPoint<FracBits, Int>> {
+
+		static constexpr bool isNumber = true;
+
+		using Compute = typename FixedPoint<FracBits, Int>::Compute;
+
+	};
+
+	// Q8.8 and Q16.16
+	using Fixed16 = FixedPoint<8, std::int16_t>;
+	using Fixed32 = FixedPoint<16, std::int32_t>;
+
+}
+
+namespace std {
+
+	template <int FracBits, typename Int>
+	class numeric_limits<bm::FixedPoint<FracBits, Int>> {
+		using F = bm::FixedPoint<FracBits, Int>;
+	public:
+		static constexpr bool is_specialized = true;
+		static constexpr bool is_signed = true;
+		static constexpr bool is_integer = false;
+		static constexpr bool is_exact = true;
+		static constexpr bool has_infinity = false;
+		static constexpr bool has_quiet_NaN = false;
+		static constexpr int radix = 2;
+		static constexpr int digits = numeric_limits<Int>::digits;
+
+		// smallest positive value, as for the floating point types
+		static constexpr F min() { return F::fromRaw(1); }
+		static constexpr F max() { return F::fromRaw(numeric_limits<Int>::max()); }
+		static constexpr F lowest() { return F::fromRaw(numeric_limits<Int>::lowest()); }
+		static constexpr F epsilon() { return F::fromRaw(1); }
+	};
+
+}
+
+#endif // !_BICYCLE_FIXED_POINT_H_
@@ -1,16 +1,353 @@
 #ifndef _BICYCLE_FUNCTION_H_
 #define _BICYCLE_FUNCTION_H_
 
+#include <algorithm>
 #include <cmath>
 #include <string>
+#include <type_traits>
+
+#include "SimdMath.h"
 
 namespace bm {
 
+    // evaluate() walks the whole expression tree for one block of this many arguments at a time,
+    // so intermediate results stay on the stack and in L1
+    constexpr int EvaluationBlock = simd::MathBlock;
+
     #define MULTIPLIER Multiplier
     #define ADDER Adder
+    #define SUBTRACTOR Subtractor
     #define DIVIDOR Dividor
 
-    #define DEFINE_FUNC_OPERATOR(NAME, OP) \
+    template <int N, typename T> struct PolynomicFunction;
+    template <typename T> struct Zero_;
+    template <typename T> struct One_;
+    template <typename LeftFunc, typename RightFunc> class MULTIPLIER;
+    template <typename LeftFunc, typename RightFunc> class ADDER;
+    template <typename LeftFunc, typename RightFunc> class SUBTRACTOR;
+    template <typename LeftFunc, typename RightFunc> class DIVIDOR;
+    template <typename InnerFunc, typename Func> class Function;
+    template <typename InnerFunc> class Negate;
+    template <typename InnerFunc, int Power> class Pow;
+    template <typename T> class Constant;
+
+    template <int Power, typename InnerFunc>
+    auto pow(InnerFunc const& func);
+
+    // Building blocks of derivative(). They fold what the types already tell: zeros and ones
+    // disappear and polynomials combine into one polynomial, everything else becomes a new node.
+    namespace _FunctionInternal {
+
+        template <typename Func>
+        using ValueOf = decltype(std::declval<Func const&>()(0));
+
+        template <typename Func> struct IsZero : std::false_type {};
+        template <typename T> struct IsZero<Zero_<T>> : std::true_type {};
+
+        template <typename Func> struct IsOne : std::false_type {};
+        template <typename T> struct IsOne<One_<T>> : std::true_type {};
+
+        // polynomials and the leaves derived from them (X_, One_, Zero_)
+        template <int N, typename T> std::true_type isPolynomial(PolynomicFunction<N, T> const*);
+        std::false_type isPolynomial(void const*);
+
+        template <typename Func>
+        constexpr bool IsPolynomial = decltype(isPolynomial(std::declval<Func const*>()))::value;
+
+        // Expressions built on T also take arguments of other element types (an Interval<T>, a Dual<T>)
+        // through a second operator(), enabled for the types T itself does not convert from.
+        template <typename Arg, typename T>
+        using OtherArgument = std::enable_if_t<!std::is_convertible<Arg, T>::value>;
+
+        template <typename Func, typename T, typename = void>
+        struct HasEvaluate : std::false_type {};
+
+        template <typename Func, typename T>
+        struct HasEvaluate<Func, T, std::void_t<decltype(std::declval<Func const&>().evaluate(std::declval<T const*>(), std::declval<T*>(), 0))>> : std::true_type {};
+
+        // ys[i] = func(xs[i]) for any callable, in batches when it has evaluate()
+        template <typename Func, typename T>
+        void sample(Func const& func, T const* xs, T* ys, int n) {
+            if constexpr (HasEvaluate<Func, T>::value) func.evaluate(xs, ys, n);
+            else for (int i = 0; i < n; ++i) ys[i] = func(xs[i]);
+        }
+
+        // the node types of this file
+        template <typename Func> struct IsNode : std::false_type {};
+        template <typename LeftFunc, typename RightFunc> struct IsNode<MULTIPLIER<LeftFunc, RightFunc>> : std::true_type {};
+        template <typename LeftFunc, typename RightFunc> struct IsNode<ADDER<LeftFunc, RightFunc>> : std::true_type {};
+        template <typename LeftFunc, typename RightFunc> struct IsNode<SUBTRACTOR<LeftFunc, RightFunc>> : std::true_type {};
+        template <typename LeftFunc, typename RightFunc> struct IsNode<DIVIDOR<LeftFunc, RightFunc>> : std::true_type {};
+        template <typename InnerFunc, typename Func> struct IsNode<Function<InnerFunc, Func>> : std::true_type {};
+        template <typename InnerFunc> struct IsNode<Negate<InnerFunc>> : std::true_type {};
+        template <typename InnerFunc, int Power> struct IsNode<Pow<InnerFunc, Power>> : std::true_type {};
+        template <typename T> struct IsNode<Constant<T>> : std::true_type {};
+
+        // operands of the elementary function factories: nodes, polynomials and everything else
+        // that prints itself as an expression, but no number
+        template <typename Func, typename = void>
+        struct IsExpression : std::false_type {};
+
+        template <typename Func>
+        struct IsExpression<Func, std::void_t<decltype(std::declval<Func const&>().toString())>> : std::true_type {};
+
+        inline std::string numberToString(double num) {
+            std::string num_str = std::to_string(num);
+            auto last_not_triling_zero_pos = num_str.find_last_not_of('0');
+            auto erase_start =
+                last_not_triling_zero_pos < num_str.length() && num_str.at(last_not_triling_zero_pos) == '.' ?
+                last_not_triling_zero_pos : last_not_triling_zero_pos + 1;
+            num_str.erase(erase_start, std::string::npos);
+            return num_str;
+        }
+
+        // A constant polynomial is only known at run time, e.g. 1 as the derivative of X + 1.0,
+        // so the nodes multiply() and add() build around it drop it when it is 0 or 1 on printing.
+        template <typename Func> struct IsConstantPolynomial : std::false_type {};
+        template <typename T> struct IsConstantPolynomial<PolynomicFunction<0, T>> : std::true_type {};
+
+        template <typename Func>
+        bool isConstant(Func const& func, int value) {
+            if constexpr (IsConstantPolynomial<Func>::value) return func(ValueOf<Func>(0)) == ValueOf<Func>(value);
+            else return false;
+        }
+
+        // (left)OP(right) without the operands that a 0 or a 1 makes neutral
+        template <char OP, typename LeftFunc, typename RightFunc>
+        std::string nodeToString(LeftFunc const& left, RightFunc const& right) {
+            if (OP == '*' && (isConstant(left, 0) || isConstant(right, 0))) return "0";
+            if ((OP == '*' && isConstant(left, 1)) || (OP == '+' && isConstant(left, 0))) return right.toString();
+            if (((OP == '*' || OP == '/') && isConstant(right, 1)) || ((OP == '+' || OP == '-') && isConstant(right, 0))) return left.toString();
+            return '(' + left.toString() + ')' + OP + '(' + right.toString() + ')';
+        }
+
+        // Node<left, right> for the operators of the nodes; a scalar right operand becomes a Constant
+        template <template <typename, typename> class Node, typename LeftFunc, typename RightFunc>
+        auto node(LeftFunc const& left, RightFunc const& right) {
+            using T = ValueOf<LeftFunc>;
+            if constexpr (std::is_convertible<RightFunc, T>::value) return Node<LeftFunc, Constant<T>>(left, Constant<T>(right));
+            else return Node<LeftFunc, RightFunc>(left, right);
+        }
+
+        // x^Power as a chain of multiplications by squaring, unrolled at compile time
+        template <int Power, typename T>
+        T power(T const& x) {
+            if constexpr (Power < 0) return T(1) / power<-Power>(x);
+            else if constexpr (Power == 0) return T(1);
+            else if constexpr (Power == 1) return x;
+            else {
+                T const half = power<Power / 2>(x);
+                if constexpr (Power % 2 == 0) return half * half;
+                else return half * half * x;
+            }
+        }
+
+        // the same chain on polynomials, the degree grows with every product
+        template <int Power, typename Poly>
+        auto polynomialPower(Poly const& poly) {
+            if constexpr (Power == 1) return poly;
+            else {
+                auto const half = polynomialPower<Power / 2>(poly);
+                if constexpr (Power % 2 == 0) return half * half;
+                else return half * half * poly;
+            }
+        }
+
+        // constant polynomial with the value type of func
+        template <typename Func>
+        auto constant(Func const&, double value) {
+            using T = ValueOf<Func>;
+            T const coefficients[1] = { T(value) };
+            return PolynomicFunction<0, T>(coefficients);
+        }
+
+        template <typename LeftFunc, typename RightFunc>
+        auto add(LeftFunc const& left, RightFunc const& right) {
+            if constexpr (IsZero<LeftFunc>::value) return right;
+            else if constexpr (IsZero<RightFunc>::value) return left;
+            else if constexpr (IsPolynomial<LeftFunc> && IsPolynomial<RightFunc>) return left + right;
+            else return ADDER<LeftFunc, RightFunc>(left, right);
+        }
+
+        template <typename Func>
+        auto negate(Func const& func) {
+            if constexpr (IsZero<Func>::value) return func;
+            else if constexpr (IsPolynomial<Func>) return -func;
+            else return Negate<Func>(func);
+        }
+
+        template <typename LeftFunc, typename RightFunc>
+        auto subtract(LeftFunc const& left, RightFunc const& right) {
+            if constexpr (IsZero<RightFunc>::value) return left;
+            else if constexpr (IsZero<LeftFunc>::value) return negate(right);
+            else if constexpr (IsPolynomial<LeftFunc> && IsPolynomial<RightFunc>) return left - right;
+            else return SUBTRACTOR<LeftFunc, RightFunc>(left, right);
+        }
+
+        template <typename LeftFunc, typename RightFunc>
+        auto multiply(LeftFunc const& left, RightFunc const& right) {
+            if constexpr (IsZero<LeftFunc>::value) return left;
+            else if constexpr (IsZero<RightFunc>::value) return right;
+            else if constexpr (IsOne<LeftFunc>::value) return right;
+            else if constexpr (IsOne<RightFunc>::value) return left;
+            else if constexpr (IsPolynomial<LeftFunc> && IsPolynomial<RightFunc>) return left * right;
+            else return MULTIPLIER<LeftFunc, RightFunc>(left, right);
+        }
+
+        template <typename LeftFunc, typename RightFunc>
+        auto divide(LeftFunc const& left, RightFunc const& right) {
+            if constexpr (IsZero<LeftFunc>::value || IsOne<RightFunc>::value) return left;
+            else return DIVIDOR<LeftFunc, RightFunc>(left, right);
+        }
+
+        template <typename LeftFunc, typename RightFunc>
+        auto sumDerivative(LeftFunc const& left, RightFunc const& right) {
+            return add(left.derivative(), right.derivative());
+        }
+
+        template <typename LeftFunc, typename RightFunc>
+        auto differenceDerivative(LeftFunc const& left, RightFunc const& right) {
+            return subtract(left.derivative(), right.derivative());
+        }
+
+        template <typename LeftFunc, typename RightFunc>
+        auto productDerivative(LeftFunc const& left, RightFunc const& right) {
+            return add(multiply(left.derivative(), right), multiply(left, right.derivative()));
+        }
+
+        template <typename LeftFunc, typename RightFunc>
+        auto quotientDerivative(LeftFunc const& left, RightFunc const& right) {
+            auto const rightDerivative = right.derivative();
+            if constexpr (IsZero<std::decay_t<decltype(rightDerivative)>>::value) {
+                return divide(left.derivative(), right);
+            }
+            else {
+                return divide(subtract(multiply(left.derivative(), right), multiply(left, rightDerivative)), multiply(right, right));
+            }
+        }
+
+    };
+
+    // The operators every node has. A scalar operand is wrapped into a Constant,
+    // a scalar or a polynomial on the left of a node goes through the free operators below.
+    #define FUNC_NODE_OPERATORS(SELF) \
+        template <typename OtherFunc> auto operator *(OtherFunc const& other) const { return _FunctionInternal::node<MULTIPLIER>(*this, other); } \
+        template <typename OtherFunc> auto operator +(OtherFunc const& other) const { return _FunctionInternal::node<ADDER>(*this, other); } \
+        template <typename OtherFunc> auto operator -(OtherFunc const& other) const { return _FunctionInternal::node<SUBTRACTOR>(*this, other); } \
+        template <typename OtherFunc> auto operator /(OtherFunc const& other) const { return _FunctionInternal::node<DIVIDOR>(*this, other); } \
+        Negate<SELF> operator-() const { return Negate<SELF>(*this); }
+
+    // A number inside an expression; scalars meeting a node are turned into it.
+    template <typename T>
+    class Constant {
+
+        T value_;
+
+    public:
+
+        explicit Constant(T const& value) : value_(value) {}
+
+        T operator()(T const&) const { return value_; }
+
+        template <typename Arg, typename = _FunctionInternal::OtherArgument<Arg, T>>
+        Arg operator()(Arg const&) const { return Arg(value_); }
+
+        void evaluate(T const*, T* res, int count) const {
+            std::fill(res, res + count, value_);
+        }
+
+        std::string toString() const { return _FunctionInternal::numberToString(value_); }
+
+        Zero_<T> derivative() const { return Zero_<T>(); }
+
+        template <typename Builder>
+        int emit(Builder& builder) const { return builder.constant(value_); }
+
+        FUNC_NODE_OPERATORS(Constant)
+
+    };
+
+    template <typename InnerFunc>
+    class Negate {
+
+        using RetT = decltype(std::declval<InnerFunc>()(0));
+
+        InnerFunc inner_;
+
+    public:
+
+        explicit Negate(InnerFunc const& inner) : inner_(inner) {}
+
+        RetT operator()(RetT x) const { return -inner_(x); }
+
+        template <typename Arg, typename = _FunctionInternal::OtherArgument<Arg, RetT>>
+        auto operator()(Arg const& x) const { return -inner_(x); }
+
+        // args and res may be the same array
+        void evaluate(RetT const* args, RetT* res, int count) const {
+            inner_.evaluate(args, res, count);
+            for (int i = 0; i < count; ++i) res[i] = -res[i];
+        }
+
+        std::string toString() const { return "-(" + inner_.toString() + ')'; }
+
+        auto derivative() const { return _FunctionInternal::negate(inner_.derivative()); }
+
+        template <typename Builder>
+        int emit(Builder& builder) const { return builder.negate(inner_.emit(builder)); }
+
+        FUNC_NODE_OPERATORS(Negate)
+
+    };
+
+    // inner^Power for a compile time integer Power, computed as a chain of multiplications
+    template <typename InnerFunc, int Power>
+    class Pow {
+
+        using RetT = decltype(std::declval<InnerFunc>()(0));
+
+        InnerFunc inner_;
+
+    public:
+
+        explicit Pow(InnerFunc const& inner) : inner_(inner) {}
+
+        RetT operator()(RetT x) const { return _FunctionInternal::power<Power>(inner_(x)); }
+
+        template <typename Arg, typename = _FunctionInternal::OtherArgument<Arg, RetT>>
+        auto operator()(Arg const& x) const { return _FunctionInternal::power<Power>(inner_(x)); }
+
+        // args and res may be the same array
+        void evaluate(RetT const* args, RetT* res, int count) const {
+            inner_.evaluate(args, res, count);
+            for (int i = 0; i < count; ++i) res[i] = _FunctionInternal::power<Power>(res[i]);
+        }
+
+        std::string toString() const { return '(' + inner_.toString() + ")^" + std::to_string(Power); }
+
+        // Power * inner^(Power - 1) * inner'
+        auto derivative() const {
+            using namespace _FunctionInternal;
+            return multiply(multiply(constant(inner_, Power), pow<Power - 1>(inner_)), inner_.derivative());
+        }
+
+        template <typename Builder>
+        int emit(Builder& builder) const { return builder.power(inner_.emit(builder), Power); }
+
+        FUNC_NODE_OPERATORS(Pow)
+
+    };
+
+    // inner^Power; polynomials are multiplied out, powers 0 and 1 need no node at all
+    template <int Power, typename InnerFunc>
+    auto pow(InnerFunc const& func) {
+        if constexpr (Power == 0) return One_<_FunctionInternal::ValueOf<InnerFunc>>();
+        else if constexpr (Power == 1) return func;
+        else if constexpr (Power > 0 && _FunctionInternal::IsPolynomial<InnerFunc>) return _FunctionInternal::polynomialPower<Power>(func);
+        else return Pow<InnerFunc, Power>(func);
+    }
+
+    #define DEFINE_FUNC_OPERATOR(NAME, OP, DERIVATIVE, EMIT) \
     template <typename LeftFunc, typename RightFunc> \
     class NAME { \
         LeftFunc left_; \
@@ -19,71 +356,124 @@ namespace bm {
     public: \
         NAME(LeftFunc const& left, RightFunc const& right) : left_(left), right_(right) {} \
         auto operator()(ValT const& arg) const { return left_(arg) OP right_(arg); } \
-        template <typename RightFunc> auto operator *(RightFunc const& right) const { return MULTIPLIER <NAME, RightFunc>(*this, right); } \
-        template <typename RightFunc> auto operator +(RightFunc const& right) const { return ADDER <NAME, RightFunc>(*this, right); } \
-        template <typename RightFunc> auto operator /(RightFunc const& right) const { return DIVIDOR <NAME, RightFunc>(*this, right); } \
-        std::string toString() const { return '(' + left_.toString() + ')' + #OP + '(' + right_.toString() + ')'; } \
-    };
+        template <typename Arg, typename = _FunctionInternal::OtherArgument<Arg, ValT>> \
+        auto operator()(Arg const& arg) const { return left_(arg) OP right_(arg); } \
+        /* the right operand goes first, so res may be args */ \
+        void evaluate(ValT const* args, ValT* res, int count) const { \
+            for (int start = 0; start < count; start += EvaluationBlock) { \
+                int const len = std::min(EvaluationBlock, count - start); \
+                ValT right[EvaluationBlock]; \
+                right_.evaluate(args + start, right, len); \
+                left_.evaluate(args + start, res + start, len); \
+                for (int i = 0; i < len; ++i) res[start + i] = res[start + i] OP right[i]; \
+            } \
+        } \
+        std::string toString() const { return _FunctionInternal::nodeToString<#OP[0]>(left_, right_); } \
+        auto derivative() const { return _FunctionInternal::DERIVATIVE(left_, right_); } \
+        /* appends the node to a Tape, see Tape.h */ \
+        template <typename Builder> int emit(Builder& builder) const { \
+            int const left = left_.emit(builder); \
+            return builder.EMIT(left, right_.emit(builder)); \
+        } \
+        FUNC_NODE_OPERATORS(NAME) \
+    }; \
+    template <typename RightFunc, typename = std::enable_if_t<_FunctionInternal::IsNode<RightFunc>::value>> \
+    auto operator OP(_FunctionInternal::ValueOf<RightFunc> const& left, RightFunc const& right) { \
+        using T = _FunctionInternal::ValueOf<RightFunc>; \
+        return NAME<Constant<T>, RightFunc>(Constant<T>(left), right); \
+    } \
+    template <typename LeftFunc, typename RightFunc, \
+        typename = std::enable_if_t<_FunctionInternal::IsPolynomial<LeftFunc> && _FunctionInternal::IsNode<RightFunc>::value>> \
+    auto operator OP(LeftFunc const& left, RightFunc const& right) { \
+        return NAME<LeftFunc, RightFunc>(left, right); \
+    }
 
-    DEFINE_FUNC_OPERATOR(MULTIPLIER, *);
-    DEFINE_FUNC_OPERATOR(ADDER, +);
-    DEFINE_FUNC_OPERATOR(DIVIDOR, /);
+    DEFINE_FUNC_OPERATOR(MULTIPLIER, *, productDerivative, multiply);
+    DEFINE_FUNC_OPERATOR(ADDER, +, sumDerivative, add);
+    DEFINE_FUNC_OPERATOR(SUBTRACTOR, -, differenceDerivative, subtract);
+    DEFINE_FUNC_OPERATOR(DIVIDOR, /, quotientDerivative, divide);
 
+    // Func is a stateless tag type for the elementary function: Func::name is its compile time name,
+    // Func::apply(x) computes it inline, Func::batch(x, y, n) on an array (x and y may be the same)
+    // and Func::derivative(g) builds the expression of f'(g).
+    // A Function holds only its inner expression, so composing copies no strings and allocates nothing.
     template <typename InnerFunc, typename Func>
     class Function {
 
-        InnerFunc inner_;
-        Func f_;
-        std::string name_;
-
         using RetT = decltype(std::declval<InnerFunc>()(0));
 
+        InnerFunc inner_;
+
     public:
 
-        Function(InnerFunc inner, Func f, std::string const& funcName)
-            : inner_(inner), f_(f), name_(funcName) {}
+        explicit Function(InnerFunc const& inner) : inner_(inner) {}
 
         RetT operator()(RetT x) const {
-            return f_(inner_(x));
+            return Func::apply(inner_(x));
         }
 
-        std::string  toString() const {
-            return name_ + '(' + inner_.toString() + ')';
+        template <typename Arg, typename = _FunctionInternal::OtherArgument<Arg, RetT>>
+        auto operator()(Arg const& x) const {
+            return Func::apply(inner_(x));
         }
 
-        template <typename RightFunc>
-        auto operator*(RightFunc const &right) const {
-            return Multiplier<Function, RightFunc>(*this, right);
+        // res[i] = (*this)(args[i]); args and res may be the same array
+        void evaluate(RetT const* args, RetT* res, int count) const {
+            for (int start = 0; start < count; start += EvaluationBlock) {
+                int const len = std::min(EvaluationBlock, count - start);
+                inner_.evaluate(args + start, res + start, len);
+                Func::batch(res + start, res + start, len);
+            }
         }
 
-        template <typename RightFunc>
-        auto operator+(RightFunc const& right) const {
-            return Adder<Function, RightFunc>(*this, right);
+        std::string  toString() const {
+            return Func::name + ('(' + inner_.toString() + ')');
         }
 
-        template <typename RightFunc>
-        auto operator/(RightFunc const& right) const {
-            return Dividor<Function, RightFunc>(*this, right);
+        // chain rule: f'(g) * g'
+        auto derivative() const {
+            return _FunctionInternal::multiply(Func::derivative(inner_), inner_.derivative());
         }
 
+        template <typename Builder>
+        int emit(Builder& builder) const {
+            return builder.template unary<Func>(inner_.emit(builder));
+        }
+
+        FUNC_NODE_OPERATORS(Function)
+
     };
 
-    #define DEFINE_FUNC(FUNC) \
-    template <typename InnerFunc> \
-    auto FUNC(InnerFunc f) { \
-        using  RetT = decltype(std::declval<InnerFunc>()(0)); \
-        RetT (*pF) (RetT) = std::FUNC; \
-        return Function<InnerFunc, decltype(pF)>(f, pF, #FUNC); \
+    // the rest of the arguments is the expression of f'(g). The factory takes expressions only and
+    // stands next to std::FUNC, so an unqualified FUNC(x) on a number inside bm still finds the library.
+    #define DEFINE_FUNC(FUNC, ...) \
+    namespace _FunctionInternal { \
+        struct FUNC##Tag { \
+            static constexpr char const* name = #FUNC; \
+            template <typename T> static T apply(T const& x) { using std::FUNC; return FUNC(x); } \
+            template <typename T> static void batch(T const* x, T* y, int n) { simd::FUNC(x, y, n); } \
+            template <typename G> static auto derivative(G const& g) { return __VA_ARGS__; } \
+        }; \
+    }; \
+    using std::FUNC; \
+    template <typename InnerFunc, typename = std::enable_if_t<_FunctionInternal::IsExpression<InnerFunc>::value>> \
+    auto FUNC(InnerFunc const& f) { \
+        return Function<InnerFunc, _FunctionInternal::FUNC##Tag>(f); \
     }
 
-    DEFINE_FUNC(sin);
-    DEFINE_FUNC(cos); 
-    DEFINE_FUNC(exp);
-    DEFINE_FUNC(sqrt);
-    DEFINE_FUNC(log);
-    DEFINE_FUNC(log10);
-    DEFINE_FUNC(sinh);
-    DEFINE_FUNC(cosh);
+    DEFINE_FUNC(sin, cos(g));
+    DEFINE_FUNC(cos, negate(sin(g)));
+    DEFINE_FUNC(exp, exp(g));
+    DEFINE_FUNC(sqrt, divide(constant(g, 0.5), sqrt(g)));
+    DEFINE_FUNC(log, divide(One_<ValueOf<G>>(), g));
+    DEFINE_FUNC(log10, divide(constant(g, 0.43429448190325182765), g));
+    DEFINE_FUNC(sinh, cosh(g));
+    DEFINE_FUNC(cosh, sinh(g));
+    DEFINE_FUNC(tan, divide(One_<ValueOf<G>>(), pow<2>(cos(g))));
+    DEFINE_FUNC(atan, divide(One_<ValueOf<G>>(), add(One_<ValueOf<G>>(), pow<2>(g))));
+    DEFINE_FUNC(tanh, subtract(One_<ValueOf<G>>(), pow<2>(tanh(g))));
+    // g / |g| has no value at 0, where abs has no derivative either
+    DEFINE_FUNC(abs, divide(g, abs(g)));
 
 }
 
@@ -0,0 +1,176 @@
+#ifndef _BICYCLE_HALF_H_
+#define _BICYCLE_HALF_H_
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+#include "Simd.h"
+
+namespace bm {
+
+	namespace _HalfInternal {
+
+		inline std::uint32_t toBits(float value) {
+			std::uint32_t bits;
+			std::memcpy(&bits, &value, sizeof(bits));
+			return bits;
+		}
+
+		inline float fromBits(std::uint32_t bits) {
+			float value;
+			std::memcpy(&value, &bits, sizeof(value));
+			return value;
+		}
+
+		// condition ? a : b on masks; a ternary lets the compiler move the float work of the unused
+		// side into a branch, and branches with float operations do not vectorize
+		inline std::uint32_t select(bool condition, std::uint32_t a, std::uint32_t b) {
+			std::uint32_t const mask = 0u - static_cast<std::uint32_t>(condition);
+			return (a & mask) | (b & ~mask);
+		}
+
+		// IEEE 754 binary16: 1 sign, 5 exponent and 10 mantissa bits.
+		// Both directions are branch free, so loops over them vectorize.
+		struct HalfCodec {
+
+			// round to nearest even, overflow to infinity, NaN stays (quiet) NaN
+			static std::uint16_t encode(float value) {
+				std::uint32_t const bits = toBits(value);
+				std::uint32_t const sign = (bits >> 16) & 0x8000u;
+				std::uint32_t const magnitude = bits & 0x7FFFFFFFu;
+				// results below the smallest normal half: adding a magic number lets the FPU round
+				// the mantissa into the low bits
+				std::uint32_t const denormalMagic = ((127 - 15) + (23 - 10) + 1) << 23;
+				std::uint32_t const subnormal = toBits(fromBits(magnitude) + fromBits(denormalMagic)) - denormalMagic;
+				std::uint32_t const mantissaOdd = (magnitude >> 13) & 1u;
+				std::uint32_t const normal = (magnitude + ((15u - 127u) << 23) + 0xFFFu + mantissaOdd) >> 13;
+				std::uint32_t const special = select(magnitude > 0x7F800000u, 0x7E00u, 0x7C00u);
+				std::uint32_t const res = select(magnitude >= ((127u + 16u) << 23), special, select(magnitude < (113u << 23), subnormal, normal));
+				return static_cast<std::uint16_t>(res | sign);
+			}
+
+			static float decode(std::uint16_t half) {
+				std::uint32_t const shiftedExponent = 0x7C00u << 13;
+				std::uint32_t const magnitude = (static_cast<std::uint32_t>(half) & 0x7FFFu) << 13;
+				std::uint32_t const exponent = magnitude & shiftedExponent;
+				std::uint32_t const rebiased = magnitude + ((127u - 15u) << 23);
+				std::uint32_t const special = rebiased + ((128u - 16u) << 23);
+				// subnormal halves become normal floats: renormalize through a float subtraction
+				std::uint32_t const subnormal = toBits(fromBits(rebiased + (1u << 23)) - fromBits(113u << 23));
+				std::uint32_t const res = select(exponent == shiftedExponent, special, select(exponent == 0, subnormal, rebiased));
+				return fromBits(res | ((static_cast<std::uint32_t>(half) & 0x8000u) << 16));
+			}
+
+			static constexpr int digits = 11;
+			static constexpr int minExponent = -13;
+			static constexpr int maxExponent = 16;
+			static constexpr std::uint16_t maxBits = 0x7BFF;
+			static constexpr std::uint16_t minBits = 0x0400;
+			static constexpr std::uint16_t epsilonBits = 0x1400;
+			static constexpr std::uint16_t infinityBits = 0x7C00;
+			static constexpr std::uint16_t quietNaNBits = 0x7E00;
+			static constexpr std::uint16_t denormMinBits = 0x0001;
+		};
+
+		// bfloat16: the upper half of a float, 8 exponent and 7 mantissa bits
+		struct BFloat16Codec {
+
+			// round to nearest even, NaN stays (quiet) NaN
+			static std::uint16_t encode(float value) {
+				std::uint32_t const bits = toBits(value);
+				std::uint32_t const rounded = (bits + 0x7FFFu + ((bits >> 16) & 1u)) >> 16;
+				std::uint32_t const res = select((bits & 0x7FFFFFFFu) > 0x7F800000u, (bits >> 16) | 0x40u, rounded);
+				return static_cast<std::uint16_t>(res);
+			}
+
+			static float decode(std::uint16_t bfloat) {
+				return fromBits(static_cast<std::uint32_t>(bfloat) << 16);
+			}
+
+			static constexpr int digits = 8;
+			static constexpr int minExponent = -125;
+			static constexpr int maxExponent = 128;
+			static constexpr std::uint16_t maxBits = 0x7F7F;
+			static constexpr std::uint16_t minBits = 0x0080;
+			static constexpr std::uint16_t epsilonBits = 0x3C00;
+			static constexpr std::uint16_t infinityBits = 0x7F80;
+			static constexpr std::uint16_t quietNaNBits = 0x7FC0;
+			static constexpr std::uint16_t denormMinBits = 0x0001;
+		};
+
+	};
+
+	// 16 bit floating point storage. Converts implicitly to and from float, so every expression
+	// on it is computed in float and only the stored result is rounded to 16 bits.
+	// Vector, Point, Matrix and Image take it as T; batches convert through simd::convert.
+	template <typename Codec>
+	struct Float16 {
+
+		constexpr Float16() : bits(0) { }
+
+		Float16(float value) : bits(Codec::encode(value)) { }
+
+		operator float() const {
+			return Codec::decode(bits);
+		}
+
+		Float16& operator+=(float other) { return *this = *this + other; }
+		Float16& operator-=(float other) { return *this = *this - other; }
+		Float16& operator*=(float other) { return *this = *this * other; }
+		Float16& operator/=(float other) { return *this = *this / other; }
+
+		static constexpr Float16 fromBits(std::uint16_t bits) {
+			Float16 res;
+			res.bits = bits;
+			return res;
+		}
+
+		std::uint16_t bits;
+
+	};
+
+	using half = Float16<_HalfInternal::HalfCodec>;
+	using bfloat16 = Float16<_HalfInternal::BFloat16Codec>;
+
+	template <typename Codec>
+	struct ScalarTraits<Float16<Codec>> {
+
+		static constexpr bool isNumber = true;
+
+		using Compute = float;
+
+	};
+
+}
+
+namespace std {
+
+	template <typename Codec>
+	class numeric_limits<bm::Float16<Codec>> {
+		using F = bm::Float16<Codec>;
+	public:
+		static constexpr bool is_specialized = true;
+		static constexpr bool is_signed = true;
+		static constexpr bool is_integer = false;
+		static constexpr bool is_exact = false;
+		static constexpr bool has_infinity = true;
+		static constexpr bool has_quiet_NaN = true;
+		static constexpr bool is_iec559 = false;
+		static constexpr int radix = 2;
+		static constexpr int digits = Codec::digits;
+		static constexpr int min_exponent = Codec::minExponent;
+		static constexpr int max_exponent = Codec::maxExponent;
+
+		static constexpr F min() { return F::fromBits(Codec::minBits); }
+		static constexpr F max() { return F::fromBits(Codec::maxBits); }
+		static constexpr F lowest() { return F::fromBits(Codec::maxBits | 0x8000); }
+		static constexpr F epsilon() { return F::fromBits(Codec::epsilonBits); }
+		static constexpr F infinity() { return F::fromBits(Codec::infinityBits); }
+		static constexpr F quiet_NaN() { return F::fromBits(Codec::quietNaNBits); }
+		static constexpr F denorm_min() { return F::fromBits(Codec::denormMinBits); }
+	};
+
+}
+
+#endif // !_BICYCLE_HALF_H_
@@ -0,0 +1,267 @@
+#ifndef _BICYCLE_INTERVAL_H_
+#define _BICYCLE_INTERVAL_H_
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "Simd.h"
+
+namespace bm {
+
+	namespace _IntervalInternal {
+
+		template <typename T>
+		struct Identity {
+			using type = T;
+		};
+
+		// keeps a parameter out of template argument deduction, so Interval<double> * 2 finds the scalar overload
+		template <typename T>
+		using NonDeduced = typename Identity<T>::type;
+
+		// Arithmetic rounded to nearest is within half an ulp of the exact value, so one step
+		// outward keeps it on the safe side without touching the rounding mode of the FPU. The
+		// math library is not held to that: glibc documents errors of about 2 ulps for sinh,
+		// tanh and log10, so its results are moved MathUlps steps out.
+		constexpr int MathUlps = 4;
+
+		template <typename T>
+		T down(T const& x, int ulps = 1) {
+			T res = x;
+			for (int i = 0; i < ulps; ++i) res = std::nextafter(res, -std::numeric_limits<T>::infinity());
+			return res;
+		}
+
+		template <typename T>
+		T up(T const& x, int ulps = 1) {
+			T res = x;
+			for (int i = 0; i < ulps; ++i) res = std::nextafter(res, std::numeric_limits<T>::infinity());
+			return res;
+		}
+
+		// 0 * inf is 0 for the bounds of intervals
+		template <typename T>
+		T product(T const& a, T const& b) {
+			return a == T() || b == T() ? T() : a * b;
+		}
+
+		// some x + k * period lies in [lo, hi]; a few ulps of slack err on the side of yes
+		template <typename T>
+		bool hitsPoint(T const& lo, T const& hi, T const& offset, T const& period) {
+			T const slack = T(4) * std::numeric_limits<T>::epsilon() * (std::abs(lo) + std::abs(hi) + T(1));
+			T const k = std::ceil((lo - slack - offset) / period);
+			return offset + k * period <= hi + slack;
+		}
+
+		template <typename T>
+		constexpr T pi = T(3.14159265358979323846);
+
+	};
+
+	// Closed interval [lo, hi] containing every value a computation on reals could give.
+	// Arithmetic and the math functions below round the bounds outward, so evaluating any
+	// expression on an interval argument gives a guaranteed enclosure of its range; it may be
+	// wider than the range, e.g. x * x for x in [-1, 2] gives [-2, 4].
+	// Math functions are found by argument dependent lookup, as for Dual.
+	template <typename T>
+	struct Interval {
+
+		constexpr Interval() : lo(), hi() { }
+
+		constexpr Interval(T const& value) : lo(value), hi(value) { }
+
+		constexpr Interval(T const& lo, T const& hi) : lo(lo), hi(hi) { }
+
+		// the whole real line, e.g. a quotient by an interval containing 0
+		static Interval entire() {
+			return Interval(-std::numeric_limits<T>::infinity(), std::numeric_limits<T>::infinity());
+		}
+
+		T width() const {
+			return hi - lo;
+		}
+
+		T mid() const {
+			return lo + (hi - lo) / T(2);
+		}
+
+		bool contains(T const& value) const {
+			return lo <= value && value <= hi;
+		}
+
+		bool contains(Interval const& other) const {
+			return lo <= other.lo && other.hi <= hi;
+		}
+
+		Interval operator-() const {
+			return Interval(-hi, -lo);
+		}
+
+		Interval operator+() const {
+			return *this;
+		}
+
+		Interval& operator+=(Interval const& other) {
+			lo = _IntervalInternal::down(lo + other.lo);
+			hi = _IntervalInternal::up(hi + other.hi);
+			return *this;
+		}
+
+		Interval& operator-=(Interval const& other) {
+			T const newLo = _IntervalInternal::down(lo - other.hi);
+			hi = _IntervalInternal::up(hi - other.lo);
+			lo = newLo;
+			return *this;
+		}
+
+		Interval& operator*=(Interval const& other) {
+			using _IntervalInternal::product;
+			T const a = product(lo, other.lo), b = product(lo, other.hi), c = product(hi, other.lo), d = product(hi, other.hi);
+			lo = _IntervalInternal::down(std::min(std::min(a, b), std::min(c, d)));
+			hi = _IntervalInternal::up(std::max(std::max(a, b), std::max(c, d)));
+			return *this;
+		}
+
+		Interval& operator/=(Interval const& other) {
+			if (other.lo <= T() && other.hi >= T()) return *this = entire();
+			T const a = lo / other.lo, b = lo / other.hi, c = hi / other.lo, d = hi / other.hi;
+			lo = _IntervalInternal::down(std::min(std::min(a, b), std::min(c, d)));
+			hi = _IntervalInternal::up(std::max(std::max(a, b), std::max(c, d)));
+			return *this;
+		}
+
+		T lo;
+		T hi;
+
+	};
+
+	#define INTERVAL_BINARY_OPERATOR(OP) \
+	template <typename T> \
+	Interval<T> operator OP(Interval<T> left, Interval<T> const& right) { return left OP##= right; } \
+	template <typename T> \
+	Interval<T> operator OP(Interval<T> left, _IntervalInternal::NonDeduced<T> const& right) { return left OP##= Interval<T>(right); } \
+	template <typename T> \
+	Interval<T> operator OP(_IntervalInternal::NonDeduced<T> const& left, Interval<T> const& right) { return Interval<T>(left) OP##= right; }
+
+	INTERVAL_BINARY_OPERATOR(+)
+	INTERVAL_BINARY_OPERATOR(-)
+	INTERVAL_BINARY_OPERATOR(*)
+	INTERVAL_BINARY_OPERATOR(/)
+
+	#undef INTERVAL_BINARY_OPERATOR
+
+	template <typename T>
+	bool operator==(Interval<T> const& left, Interval<T> const& right) {
+		return left.lo == right.lo && left.hi == right.hi;
+	}
+
+	template <typename T>
+	bool operator!=(Interval<T> const& left, Interval<T> const& right) {
+		return !(left == right);
+	}
+
+	// increasing functions map the bounds; LO and HI clamp to the range of the function
+	#define INTERVAL_MONOTONIC_FUNC(FUNC, LO, HI) \
+	template <typename T> \
+	Interval<T> FUNC(Interval<T> const& x) { \
+		using std::FUNC; \
+		return Interval<T>(std::max(_IntervalInternal::down(FUNC(x.lo), _IntervalInternal::MathUlps), T(LO)), std::min(_IntervalInternal::up(FUNC(x.hi), _IntervalInternal::MathUlps), T(HI))); \
+	}
+
+	INTERVAL_MONOTONIC_FUNC(exp, 0, std::numeric_limits<T>::infinity())
+	INTERVAL_MONOTONIC_FUNC(sinh, -std::numeric_limits<T>::infinity(), std::numeric_limits<T>::infinity())
+	INTERVAL_MONOTONIC_FUNC(tanh, -1, 1)
+	INTERVAL_MONOTONIC_FUNC(atan, -_IntervalInternal::up(_IntervalInternal::pi<T> / T(2)), _IntervalInternal::up(_IntervalInternal::pi<T> / T(2)))
+
+	#undef INTERVAL_MONOTONIC_FUNC
+
+	// log, log10 and sqrt of the part of x inside their domain; sqrt is rounded like arithmetic
+	#define INTERVAL_DOMAIN_FUNC(FUNC, AT_ZERO, ULPS) \
+	template <typename T> \
+	Interval<T> FUNC(Interval<T> const& x) { \
+		using std::FUNC; \
+		T const lo = x.lo > T() ? _IntervalInternal::down(FUNC(x.lo), ULPS) : T(AT_ZERO); \
+		return Interval<T>(lo, _IntervalInternal::up(FUNC(x.hi), ULPS)); \
+	}
+
+	INTERVAL_DOMAIN_FUNC(log, -std::numeric_limits<T>::infinity(), _IntervalInternal::MathUlps)
+	INTERVAL_DOMAIN_FUNC(log10, -std::numeric_limits<T>::infinity(), _IntervalInternal::MathUlps)
+	INTERVAL_DOMAIN_FUNC(sqrt, 0, 1)
+
+	#undef INTERVAL_DOMAIN_FUNC
+
+	// the values at the ends, widened to 1 / -1 where a maximum / minimum lies inside
+	template <typename T>
+	Interval<T> sin(Interval<T> const& x) {
+		using std::sin;
+		T const twoPi = T(2) * _IntervalInternal::pi<T>, halfPi = _IntervalInternal::pi<T> / T(2);
+		if (!(x.hi - x.lo < twoPi)) return Interval<T>(T(-1), T(1));
+		T const a = sin(x.lo), b = sin(x.hi);
+		T const lo = _IntervalInternal::hitsPoint(x.lo, x.hi, -halfPi, twoPi) ? T(-1) : _IntervalInternal::down(std::min(a, b), _IntervalInternal::MathUlps);
+		T const hi = _IntervalInternal::hitsPoint(x.lo, x.hi, halfPi, twoPi) ? T(1) : _IntervalInternal::up(std::max(a, b), _IntervalInternal::MathUlps);
+		return Interval<T>(std::max(lo, T(-1)), std::min(hi, T(1)));
+	}
+
+	template <typename T>
+	Interval<T> cos(Interval<T> const& x) {
+		using std::cos;
+		T const twoPi = T(2) * _IntervalInternal::pi<T>;
+		if (!(x.hi - x.lo < twoPi)) return Interval<T>(T(-1), T(1));
+		T const a = cos(x.lo), b = cos(x.hi);
+		T const lo = _IntervalInternal::hitsPoint(x.lo, x.hi, _IntervalInternal::pi<T>, twoPi) ? T(-1) : _IntervalInternal::down(std::min(a, b), _IntervalInternal::MathUlps);
+		T const hi = _IntervalInternal::hitsPoint(x.lo, x.hi, T(0), twoPi) ? T(1) : _IntervalInternal::up(std::max(a, b), _IntervalInternal::MathUlps);
+		return Interval<T>(std::max(lo, T(-1)), std::min(hi, T(1)));
+	}
+
+	// increasing between the poles, the whole line across one
+	template <typename T>
+	Interval<T> tan(Interval<T> const& x) {
+		using std::tan;
+		T const pi = _IntervalInternal::pi<T>;
+		if (!(x.hi - x.lo < pi) || _IntervalInternal::hitsPoint(x.lo, x.hi, pi / T(2), pi)) return Interval<T>::entire();
+		return Interval<T>(_IntervalInternal::down(tan(x.lo), _IntervalInternal::MathUlps), _IntervalInternal::up(tan(x.hi), _IntervalInternal::MathUlps));
+	}
+
+	template <typename T>
+	Interval<T> cosh(Interval<T> const& x) {
+		using std::cosh;
+		T const a = cosh(x.lo), b = cosh(x.hi);
+		T const lo = x.contains(T()) ? T(1) : std::max(_IntervalInternal::down(std::min(a, b), _IntervalInternal::MathUlps), T(1));
+		return Interval<T>(lo, _IntervalInternal::up(std::max(a, b), _IntervalInternal::MathUlps));
+	}
+
+	// exact, no rounding involved
+	template <typename T>
+	Interval<T> abs(Interval<T> const& x) {
+		if (x.lo >= T()) return x;
+		if (x.hi <= T()) return -x;
+		return Interval<T>(T(), std::max(-x.lo, x.hi));
+	}
+
+	template <typename T>
+	Interval<T> fabs(Interval<T> const& x) {
+		return abs(x);
+	}
+
+	// a * b + c, in two roundings
+	template <typename T>
+	Interval<T> fma(Interval<T> const& a, Interval<T> const& b, Interval<T> const& c) {
+		return a * b + c;
+	}
+
+	template <typename T>
+	struct ScalarTraits<Interval<T>> {
+
+		static constexpr bool isNumber = ScalarTraits<T>::isNumber;
+
+		using Compute = Interval<T>;
+
+	};
+
+	using Intervalf = Interval<float>;
+	using Intervald = Interval<double>;
+
+}
+
+#endif // !_BICYCLE_INTERVAL_H_
@@ -2,6 +2,7 @@
 #define _BICYCLE_MATRIX_H_
 
 #include <type_traits>
+#include "Simd.h"
 #include "Vector.h"
 #include "Point.h"
 
@@ -13,11 +14,22 @@ namespace bm {
 	template <int Rows, int Cols, typename T, typename IsSquare>
 	struct MatrixSpec;
 
+	template <typename T>
+	struct DynamicMatrix;
+
 	// how to instantiate Row for const T? It doesnt require scale, add, swap, ...
 	// Can I do next: template <int Len, typename T> class Row <Len, const T> ?
 	// Maybe we dont need Row class at all, it is vector. Ask Dmytro
-	template <int Len, typename T>
+	// Stride is the padded row length of the owning matrix. Elements in [Len, Stride) are zero padding,
+	// row operations run over the whole Stride so their loops need no scalar remainder.
+	// Rows of a padded matrix start on simd::Layout<T>::alignment, the kernels below rely on it.
+	template <int Len, typename T, int Stride = Len>
 	class Row {
+
+		using Layout = simd::Layout<std::remove_const_t<T>>;
+
+		static constexpr std::size_t Alignment = Stride == Layout::stride(Len) ? Layout::alignment : alignof(T);
+
 	public:
 		Row(T* row_data) : m_row_data(row_data) { }
 
@@ -29,26 +41,33 @@ namespace bm {
 			return m_row_data[i];
 		}
 
+		T* data() const {
+			return m_row_data;
+		}
+
+		void fill(T const& value) {
+			simd::fill<Alignment>(m_row_data, value, Len);
+		}
+
 		void scale(T const& s, bool multiply = true) {
-			if (multiply) for (int i = 0; i < Len; ++i) m_row_data[i] = m_row_data[i] * s;
-			else for (int i = 0; i < Len; ++i) m_row_data[i] = m_row_data[i] / s;
+			if (multiply) simd::scal<Alignment>(m_row_data, s, Stride);
+			else simd::invScal<Alignment>(m_row_data, s, Stride);
 		}
 
-		void add(Row<Len, T> const& row) {
-			for (int i = 0; i < Len; ++i) m_row_data[i] = m_row_data[i] + row.at(i);
+		template <typename OtherT>
+		void add(Row<Len, OtherT, Stride> const& row) {
+			simd::add<Alignment>(m_row_data, row.data(), Stride);
 		}
 
-		void addScaled(Row<Len, T> const& row, T const& s, bool multiply = true) {
-			if (multiply) for (int i = 0; i < Len; ++i) m_row_data[i] = m_row_data[i] + row.at(i) * s;
-			else for (int i = 0; i < Len; ++i) m_row_data[i] = m_row_data[i] + row.at(i) / s;
+		template <typename OtherT>
+		void addScaled(Row<Len, OtherT, Stride> const& row, T const& s, bool multiply = true) {
+			if (multiply) simd::axpy<Alignment>(m_row_data, row.data(), s, Stride);
+			else simd::invAxpy<Alignment>(m_row_data, row.data(), s, Stride);
 		}
 
-		void swap(bm::Row<Len, T>& other) {
-			for (int i = 0; i < Len; ++i) {
-				T temp = m_row_data[i];
-				m_row_data[i] = other[i];
-				other[i] = temp;
-			}
+		// Row is a view, so a temporary returned by Matrix::operator[] can be swapped with
+		void swap(bm::Row<Len, T, Stride> other) {
+			simd::swap<Alignment>(m_row_data, other.data(), Stride);
 		}
 
 	private:
@@ -60,19 +79,97 @@ namespace bm {
 		template <int Rows, int Cols, typename T>
 		friend struct Matrix;
 
+		template <typename T>
+		friend struct DynamicMatrix;
+
+		// Gauss-Jordan elimination shared by fixed and dynamic matrices. MatT is any square matrix
+		// whose operator[] returns a row view with swap, addScaled and scale.
+		template <typename T, typename MatT>
+		static void invert(MatT& this_copy, MatT& identity, int n) {
+			for (int i = 0; i < n - 1; ++i) {
+				if (!this_copy[i][i]) {
+					for (int j = i + 1; j < n; ++j) {
+						if (this_copy[j][i]) {
+							this_copy[j].swap(this_copy[i]);
+							identity[j].swap(identity[i]);
+							break;
+						}
+					}
+				}
+				for (int j = i + 1; j < n; ++j) {
+					if (this_copy[j][i]) {
+						const T scale = -(this_copy[j][i] / this_copy[i][i]);
+						this_copy[j].addScaled(this_copy[i], scale);
+						identity[j].addScaled(identity[i], scale);
+					}
+				}
+			}
+			for (int i = n - 1; i > 0; --i) {
+				for (int j = i - 1; j >= 0; --j) {
+					if (this_copy[j][i]) {
+						const T scale = -(this_copy[j][i] / this_copy[i][i]);
+						// here we need to add only one element then all row
+						this_copy[j].addScaled(this_copy[i], scale);
+						identity[j].addScaled(identity[i], scale);
+					}
+				}
+			}
+			for (int i = 0; i < n; ++i) {
+				const T scale = this_copy[i][i];
+				this_copy[i][i] /= scale;
+				identity[i].scale(scale, false);
+			}
+		}
+
+		template <typename T, typename MatT>
+		static T determinant(MatT& this_copy, int n) {
+			bool inverted = false;
+			for (int i = 0; i < n - 1; ++i) {
+				// ask Dmytro if I need to make mat[i][i] != T() comparison
+				if (!this_copy[i][i]) {
+					bool swaped = false;
+					for (int j = i + 1; j < n; ++j) {
+						if (this_copy[j][i]) {
+							this_copy[j].swap(this_copy[i]);
+							swaped = true;
+							break;
+						}
+					}
+					if (!swaped) {
+						return this_copy[i][i];
+					}
+					else {
+						inverted = !inverted;
+					}
+				}
+				for (int j = i + 1; j < n; ++j) {
+					if (this_copy[j][i]) {
+						this_copy[j].addScaled(this_copy[i], -(this_copy[j][i] / this_copy[i][i]));
+					}
+				}
+			}
+			T det = this_copy[0][0];
+			for (int i = 1; i < n; ++i) {
+				det *= this_copy[i][i];
+			}
+			// unar minus sign
+			// is it ok?
+			return inverted ? T(-det) : det;
+		}
+
 		template <int Rows, int Cols, typename T, typename IsArithmeticSquare = void>
 		struct InitMatrixDefault
 		{
-			void init(T(&matrix_array)[Rows * Cols]) { }
+			void init(T*, int) { }
 		};
 
 		template <int Rows, int Cols, typename T>
-		struct InitMatrixDefault<Rows, Cols, T, std::enable_if_t<(Rows == Cols && std::is_arithmetic<T>::value)>>
+		struct InitMatrixDefault<Rows, Cols, T, std::enable_if_t<(Rows == Cols && ScalarTraits<T>::isNumber)>>
 		{
-			void init(T(&matrix_array)[Rows * Cols]) {
+			void init(T* matrix_array, int stride) {
 				T const diagonal_value = static_cast<T>(1);
 				for (int i = 0; i < Rows; ++i) {
-					int const array_index = i * Rows + i;
+					int const array_index = i * stride + i;
 					matrix_array[array_index] = diagonal_value;
 				}
 			}
@@ -81,47 +178,53 @@ namespace bm {
 		template <int Rows, int Cols, typename T>
 		struct MatrixBase {
 
+			using Layout = simd::Layout<T>;
+
+			// distance between the starts of two neighbouring rows, Cols rounded up to the vector width
+			static constexpr int Stride = Layout::stride(Cols);
+
 			MatrixBase() {
 				InitMatrixDefault<Rows, Cols, T> data_initializer;
-				data_initializer.init(m_vals);
+				data_initializer.init(m_vals, Stride);
 			}
 
 			MatrixBase(T const (&data)[Rows * Cols]) {
 				for (int i = 0; i < Rows; ++i) {
-					int const index = i * Cols;
+					int const index = i * Stride;
+					int const data_index = i * Cols;
 					for (int j = 0; j < Cols; ++j) {
-						m_vals[index + j] = T(data[index + j]);
+						m_vals[index + j] = T(data[data_index + j]);
 					}
 				}
 			}
 
-			Row<Cols, T> operator[](int i) {
+			Row<Cols, T, Stride> operator[](int i) {
 				return row(i);
 			}
 
-			Row<Cols, const T> const at(int i) const {
+			Row<Cols, const T, Stride> const at(int i) const {
 				return row(i);
 			}
 
-			Row<Cols, T> row(int i) {
-				return Row<Cols, T>(m_vals + i * Cols);
+			Row<Cols, T, Stride> row(int i) {
+				return Row<Cols, T, Stride>(m_vals + i * Stride);
 			}
 
-			Row<Cols, const T> row(int i) const {
-				return Row<Cols, const T>(m_vals + i * Cols);
+			Row<Cols, const T, Stride> row(int i) const {
+				return Row<Cols, const T, Stride>(m_vals + i * Stride);
 			}
 
 			T& at(int i, int j) {
-				return m_vals[i * Cols + j];
+				return m_vals[i * Stride + j];
 			}
 
 			T const& at(int i, int j) const {
-				return m_vals[i * Cols + j];
+				return m_vals[i * Stride + j];
 			}
 
 		protected:
 
-			T m_vals[Rows * Cols] = { T() };
+			alignas(Layout::alignment) T m_vals[Rows * Stride] = { T() };
 
 		};
 
@@ -137,78 +240,14 @@ namespace bm {
 
 
 			Matrix<Cols, Rows, T> inv() const {
-				Matrix<Cols, Rows, T> identity, this_copy(m_vals);
-				for (int i = 0; i < Rows - 1; ++i) {
-					if (!this_copy[i][i]) {
-						for (int j = i + 1; j < Rows; ++j) {
-							if (this_copy[j][i]) {
-								this_copy[j].swap(this_copy[i]);
-								identity[j].swap(identity[i]);
-								break;
-							}
-						}
-					}
-					for (int j = i + 1; j < Rows; ++j) {
-						if (this_copy[j][i]) {
-							const T scale = -(this_copy[j][i] / this_copy[i][i]);
-							this_copy[j].addScaled(this_copy[i], scale);
-							identity[j].addScaled(identity[i], scale);
-						}
-					}
-				}
-				for (int i = Rows - 1; i > 0; --i) {
-					for (int j = i - 1; j >= 0; --j) {
-						if (this_copy[j][i]) {
-							const T scale = -(this_copy[j][i] / this_copy[i][i]);
-							// here we need to add only one element then all row
-							this_copy[j].addScaled(this_copy[i], scale);
-							identity[j].addScaled(identity[i], scale);
-						}
-					}
-				}
-				for (int i = 0; i < Rows; ++i) {
-					const T scale = this_copy[i][i];
-					this_copy[i][i] /= scale;
-					identity[i].scale(scale, false);
-				}
-
+				Matrix<Cols, Rows, T> identity, this_copy(static_cast<Matrix<Rows, Cols, T> const&>(*this));
+				invert<T>(this_copy, identity, Rows);
 				return identity;
 			}
 
 			T det() const {
-				Matrix<Rows, Cols, T> this_copy(m_vals);
-				bool inverted = false;
-				for (int i = 0; i < Rows - 1; ++i) {
-					// ask Dmytro if I need to make mat[i][i] != T() comparison
-					if (!this_copy[i][i]) {
-						bool swaped = false;
-						for (int j = i + 1; j < Rows; ++j) {
-							if (this_copy[j][i]) {
-								this_copy[j].swap(this_copy[i]);
-								swaped = true;
-								break;
-							}
-						}
-						if (!swaped) {
-							return this_copy[i][i];
-						}
-						else {
-							inverted = !inverted;
-						}
-					}
-					for (int j = i + 1; j < Rows; ++j) {
-						if (this_copy[j][i]) {
-							this_copy[j].addScaled(this_copy[i], -(this_copy[j][i] / this_copy[i][i]));
-						}
-					}
-				}
-				T det = this_copy[0][0];
-				for (int i = 1; i < Rows; ++i) {
-					det *= this_copy[i][i];
-				}
-				// unar minus sign
-				// is it ok?
-				return inverted ? -det : det;
+				Matrix<Rows, Cols, T> this_copy(static_cast<Matrix<Rows, Cols, T> const&>(*this));
+				return determinant<T>(this_copy, Rows);
 			}
 		};
 
@@ -229,15 +268,15 @@ namespace bm {
 			return resMat;
 		}
 
+		// i-k-j order: every result row is accumulated with axpy over whole rows of other
 		template <int OtherCols>
 		Matrix<Rows, OtherCols, T> operator*(Matrix<Cols, OtherCols, T> const& other) const {
 			Matrix<Rows, OtherCols, T> resMat;
 			for (int i = 0; i < Rows; ++i) {
-				for (int j = 0; j < OtherCols; ++j) {
-					resMat.at(i, j) = at(i, 0) * other.at(0, j);
-					for (int k = 1; k < Cols; ++k) {
-						resMat.at(i, j) = resMat.at(i, j) + at(i, k) * other.at(k, j);
-					}
+				auto resRow = resMat[i];
+				resRow.fill(T());
+				for (int k = 0; k < Cols; ++k) {
+					resRow.addScaled(other.at(k), at(i, k));
 				}
 			}
 			return resMat;
@@ -0,0 +1,62 @@
+#ifndef _BICYCLE_PARALLEL_H_
+#define _BICYCLE_PARALLEL_H_
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace bm {
+
+	namespace parallel {
+
+		// Below this much work (elements or flops) a loop is not worth spreading over threads.
+		constexpr int MinWorkPerThread = 1 << 16;
+
+		inline std::atomic<int>& threadCountSetting() {
+			static std::atomic<int> count(0);
+			return count;
+		}
+
+		// 0 restores the default of one thread per hardware core
+		inline void setThreadCount(int count) {
+			threadCountSetting() = count;
+		}
+
+		inline int threadCount() {
+			int const count = threadCountSetting();
+			if (count > 0) return count;
+			return std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+		}
+
+		// Splits [0, n) into chunks contiguous pieces and calls body(chunk, begin, end) for each
+		// of them on its own thread. Returns once all chunks are done.
+		template <typename Body>
+		void forChunks(int chunks, int n, Body const& body) {
+			if (n <= 0) return;
+			chunks = std::max(1, std::min(chunks, n));
+			auto chunkBegin = [n, chunks](int chunk) {
+				return static_cast<int>(static_cast<long long>(n) * chunk / chunks);
+			};
+			std::vector<std::thread> workers;
+			workers.reserve(chunks - 1);
+			for (int chunk = 1; chunk < chunks; ++chunk) {
+				workers.emplace_back([&body, &chunkBegin, chunk]() { body(chunk, chunkBegin(chunk), chunkBegin(chunk + 1)); });
+			}
+			body(0, 0, chunkBegin(1));
+			for (auto& worker : workers) worker.join();
+		}
+
+		// Calls body(begin, end) over [0, n) on up to threadCount() threads,
+		// giving every thread at least grain iterations.
+		template <typename Body>
+		void forRange(int n, int grain, Body const& body) {
+			int const chunks = std::min(threadCount(), n / std::max(grain, 1));
+			forChunks(chunks, n, [&body](int, int begin, int end) { body(begin, end); });
+		}
+
+	}
+
+}
+
+#endif // !_BICYCLE_PARALLEL_H_
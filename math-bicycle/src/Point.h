@@ -6,6 +6,7 @@
 #include <string>
 #include <cmath>
 #include <cassert>
+#include <utility>
 
 namespace bm {
 
@@ -26,6 +27,17 @@ namespace bm {
 			return RETURN_T(init_array); \
 		}
 
+		// Point OP Vector or Point - Point of another element type, computed directly in the common type
+		#define MIXED_BINARY_OPERATOR(OP, RETURN_T, OTHER_T) \
+		template <typename OtherT, typename = std::enable_if_t<!std::is_same<T, OtherT>::value>> \
+		auto operator OP(OTHER_T<Len, OtherT> const& other) const { \
+			RETURN_T<Len, std::common_type_t<T, OtherT>> res; \
+			for (int i = 0; i < Len; ++i) { \
+				res[i] = this->vals[i] OP other.at(i); \
+			} \
+			return res; \
+		}
+
 		template <int Len, typename T>
 		struct PointBase {
 
@@ -41,11 +53,29 @@ namespace bm {
 				static_assert(sizeof...(args) == Len, "Number of point constructor arguments should be equal to its length.");
 			}
 
+			// element type conversion straight into vals, without a temporary array
+			template <typename FromType>
+			explicit PointBase(Point<Len, FromType> const& other) : PointBase(other, std::make_index_sequence<Len>()) { }
+
 			#define TEMPLATE_POINT Point<Len, T>
 			#define TEMPLATE_VECTOR Vector<Len, T>
 			BINARY_OPERATOR(+, TEMPLATE_POINT, TEMPLATE_VECTOR, .at(i));
 			BINARY_OPERATOR(-, TEMPLATE_POINT, TEMPLATE_VECTOR, .at(i));
 			BINARY_OPERATOR(-, TEMPLATE_VECTOR, TEMPLATE_POINT, .vals[i]);
+			#undef TEMPLATE_POINT
+			#undef TEMPLATE_VECTOR
+
+			MIXED_BINARY_OPERATOR(+, Point, Vector);
+			MIXED_BINARY_OPERATOR(-, Point, Vector);
+			MIXED_BINARY_OPERATOR(-, Vector, Point);
+
+			T const* data() const {
+				return vals;
+			}
+
+			T* data() {
+				return vals;
+			}
 
 			T const& at(int index) const {
 				assert(index >= 0 && index < Len);
@@ -72,7 +102,15 @@ namespace bm {
 
 			T vals[Len];
 
+		private:
+
+			template <typename FromType, std::size_t ...I>
+			PointBase(Point<Len, FromType> const& other, std::index_sequence<I...>) : vals{ T(other.at(I))... } { }
+
 		};
+
+		#undef BINARY_OPERATOR
+		#undef MIXED_BINARY_OPERATOR
 	};
 
 	#define POINT_ASSIGN_OPERATOR(Len) \
@@ -86,6 +124,8 @@ namespace bm {
 
 		using _PointInternal::PointBase<Len, T>::PointBase;
 
+		Point(Point const& other) = default;
+
 		POINT_ASSIGN_OPERATOR(Len);
 
 	};
@@ -167,11 +207,20 @@ namespace bm {
 	}
 
 
+	// converts like simd::convert, so floats going to unsigned char or short saturate
 	template <typename ToType, typename FromType, int Len>
 	Point<Len, ToType> changeT(Point<Len, FromType> const& fromVec) {
-		ToType initArray[Len] = { ToType() };
-		for (int i = 0; i < Len; ++i) initArray[i] = ToType(fromVec.at(i));
-		return Point<Len, ToType>(initArray);
+		Point<Len, ToType> res;
+		simd::convert(fromVec.data(), res.data(), Len);
+		return res;
+	}
+
+	// converts count points at once, e.g. a sampled curve before drawing, with the same saturation
+	template <typename ToType, typename FromType, int Len>
+	void changeT(Point<Len, FromType> const* fromPoints, Point<Len, ToType>* toPoints, int count) {
+		simd::convertObjects<ToType, FromType>(
+			count, Len, [fromPoints](int i) { return fromPoints[i].data(); }, [toPoints](int i) { return toPoints[i].data(); }
+		);
 	}
 
 	using Point4f = Point<4, float>;
@@ -0,0 +1,221 @@
+#ifndef _BICYCLE_POLYNOMIAL_H_
+#define _BICYCLE_POLYNOMIAL_H_
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <initializer_list>
+#include <string>
+
+#include "DynamicMatrix.h"
+#include "DynamicVector.h"
+#include "Function.h"
+#include "PolynomicFunction.h"
+#include "Vector.h"
+
+namespace bm {
+
+	// Polynomial whose degree is known only at runtime, so products and data dependent fits keep
+	// one type. Coefficients are kept highest power first, as in PolynomicFunction, in a
+	// DynamicVector, so degrees below InlineCapacity never touch the heap. Leading zero
+	// coefficients are dropped, degree() is the true degree and 0 for the zero polynomial.
+	template <typename T, int InlineCapacity = 16>
+	struct Polynomial {
+
+		template <typename T2, int InlineCapacity2>
+		friend struct Polynomial;
+
+		Polynomial() : m_coefficients(1) { }
+
+		// count = degree + 1 coefficients, highest power first
+		Polynomial(T const* coefficients, int count) : m_coefficients(coefficients, count) {
+			assert(count > 0);
+			trim();
+		}
+
+		Polynomial(std::initializer_list<T> coefficients) : Polynomial(coefficients.begin(), static_cast<int>(coefficients.size())) { }
+
+		template <int N>
+		Polynomial(PolynomicFunction<N, T> const& poly) : Polynomial(poly.m_coefficients, N + 1) { }
+
+		// the same polynomial with the degree in the type, which must be at least degree()
+		template <int N>
+		PolynomicFunction<N, T> toPolynomic() const {
+			assert(degree() <= N);
+			T coefficients[N + 1] = { T() };
+			std::copy(m_coefficients.begin(), m_coefficients.end(), coefficients + N - degree());
+			return PolynomicFunction<N, T>(coefficients);
+		}
+
+		int degree() const {
+			return m_coefficients.size() - 1;
+		}
+
+		// coefficient of X^power, 0 above the degree
+		T coefficient(int power) const {
+			assert(power >= 0);
+			return power > degree() ? T() : m_coefficients.at(degree() - power);
+		}
+
+		T operator()(T const& arg) const {
+			using std::fma;
+			T const* coefficients = m_coefficients.data();
+			T res = coefficients[0];
+			for (int i = 1, n = degree(); i <= n; ++i) { res = fma(res, arg, coefficients[i]); }
+			return res;
+		}
+
+		// Horner in the element type of arg, e.g. an Interval<T>
+		template <typename Arg, typename = _FunctionInternal::OtherArgument<Arg, T>>
+		Arg operator()(Arg const& arg) const {
+			using std::fma;
+			T const* coefficients = m_coefficients.data();
+			Arg res = Arg(coefficients[0]);
+			for (int i = 1, n = degree(); i <= n; ++i) { res = fma(res, arg, Arg(coefficients[i])); }
+			return res;
+		}
+
+		// res[i] = (*this)(args[i]) with the same roundings, in blocks and threads as for
+		// PolynomicFunction; args and res may be the same array
+		void evaluate(T const* args, T* res, int count) const {
+			_PolynomicFunctionInternal::horner(m_coefficients.data(), degree(), args, res, count);
+		}
+
+		Polynomial derivative() const {
+			int const n = degree();
+			if (n == 0) return Polynomial();
+			Polynomial res;
+			res.m_coefficients = DynamicVector<T, InlineCapacity>(n);
+			for (int i = 0; i < n; ++i) { res.m_coefficients[i] = m_coefficients.at(i) * T(n - i); }
+			res.trim();
+			return res;
+		}
+
+		// appends the polynomial of the argument to a Tape, see Tape.h
+		template <typename Builder>
+		int emit(Builder& builder) const {
+			return builder.polynomial(builder.argument(), m_coefficients.data(), degree());
+		}
+
+		// term by term, by Karatsuba or by FFT with the degrees, see _PolynomicFunctionInternal::multiply
+		Polynomial operator*(Polynomial const& other) const {
+			int const n = degree(), n2 = other.degree();
+			Polynomial res;
+			res.m_coefficients = DynamicVector<T, InlineCapacity>(n + n2 + 1);
+			_PolynomicFunctionInternal::multiply(m_coefficients.data(), n + 1, other.m_coefficients.data(), n2 + 1, res.m_coefficients.data());
+			res.trim();
+			return res;
+		}
+
+		Polynomial operator+(Polynomial const& other) const {
+			return combine(other, T(1));
+		}
+
+		Polynomial operator-(Polynomial const& other) const {
+			return combine(other, T(-1));
+		}
+
+		Polynomial operator*(T const& scale) const {
+			Polynomial res(*this);
+			for (T& coefficient : res.m_coefficients) { coefficient *= scale; }
+			res.trim();
+			return res;
+		}
+
+		Polynomial operator+(T const& add) const {
+			Polynomial res(*this);
+			res.m_coefficients[degree()] += add;
+			res.trim();
+			return res;
+		}
+
+		Polynomial operator-(T const& sub) const {
+			return operator+(-sub);
+		}
+
+		Polynomial operator-() const {
+			return operator*(T(-1));
+		}
+
+		bool operator==(Polynomial const& other) const {
+			return m_coefficients == other.m_coefficients;
+		}
+
+		bool operator!=(Polynomial const& other) const {
+			return !(*this == other);
+		}
+
+		std::string toString() const {
+			return _PolynomicFunctionInternal::toString(m_coefficients.data(), degree());
+		}
+
+		// the degree() + 1 coefficients, highest power first
+		T const* coefficients() const {
+			return m_coefficients.data();
+		}
+
+	private:
+
+		// *this + sign * other, aligned at the constant terms
+		Polynomial combine(Polynomial const& other, T const& sign) const {
+			int const n = degree(), n2 = other.degree(), maxN = std::max(n, n2);
+			Polynomial res;
+			res.m_coefficients = DynamicVector<T, InlineCapacity>(maxN + 1);
+			for (int i = 0; i <= n; ++i) { res.m_coefficients[maxN - n + i] = m_coefficients.at(i); }
+			for (int i = 0; i <= n2; ++i) { res.m_coefficients[maxN - n2 + i] += sign * other.m_coefficients.at(i); }
+			res.trim();
+			return res;
+		}
+
+		void trim() {
+			int leadingZeros = 0;
+			while (leadingZeros < degree() && m_coefficients.at(leadingZeros) == T()) ++leadingZeros;
+			if (leadingZeros == 0) return;
+			DynamicVector<T, InlineCapacity> trimmed(m_coefficients.data() + leadingZeros, m_coefficients.size() - leadingZeros);
+			m_coefficients = std::move(trimmed);
+		}
+
+		DynamicVector<T, InlineCapacity> m_coefficients;
+
+	};
+
+	template <typename T, int InlineCapacity>
+	Polynomial<T, InlineCapacity> operator*(T const& scale, Polynomial<T, InlineCapacity> const& poly) {
+		return poly * scale;
+	}
+
+	using Polynomialf = Polynomial<float>;
+	using Polynomiald = Polynomial<double>;
+
+	// Least squares polynomial of the given degree through count points, by the normal equations;
+	// with count == degree + 1 it passes through every point, as fitPoly does. The degree is
+	// a runtime value, e.g. raised until the residual is small enough.
+	template <typename T>
+	Polynomial<T> fitPolynomial(Vector<2, T> const* points, int count, int degree) {
+		assert(degree >= 0 && count > degree);
+		int const n = degree + 1;
+		DynamicMatrix<T> normal(n, n);
+		DynamicVector<T> rhs(n);
+		// a new square matrix is the identity
+		for (int i = 0; i < n; ++i) normal.at(i, i) = T();
+		// rows of the Vandermonde matrix, highest power first
+		DynamicVector<T> powers(n);
+		for (int p = 0; p < count; ++p) {
+			T const x = points[p].x, y = points[p].y;
+			T power = T(1);
+			for (int j = n - 1; j >= 0; --j) {
+				powers[j] = power;
+				power *= x;
+			}
+			for (int i = 0; i < n; ++i) {
+				for (int j = 0; j < n; ++j) normal.at(i, j) += powers.at(i) * powers.at(j);
+				rhs[i] += powers.at(i) * y;
+			}
+		}
+		DynamicVector<T> const coefficients = normal.inv() * rhs;
+		return Polynomial<T>(coefficients.data(), n);
+	}
+
+}
+
+#endif // !_BICYCLE_POLYNOMIAL_H_
@@ -3,12 +3,17 @@
 
 #include <array>
 #include <cmath>
+#include <complex>
 #include <string>
 #include <initializer_list>
+#include <type_traits>
+#include <vector>
 
+#include "FFT.h"
 #include "Matrix.h"
 #include "Vector.h"
 #include "Function.h"
+#include "Parallel.h"
 
 namespace bm {
 
@@ -16,33 +21,269 @@ namespace bm {
 
 	#define POL_FUNC_POW(N1, N2) (N1 + N2)
 
+	template <typename T, int InlineCapacity> struct Polynomial;
+
+	namespace _PolynomicFunctionInternal {
+
+		// coefficients highest power first, as both polynomial types keep them
+		template <typename T>
+		std::string toString(T const* coefficients, int degree) {
+			auto continue_polynom_string = [](std::string& src, T const& coef, int pow) {
+				if (!coef) return;
+				auto str_coef = _FunctionInternal::numberToString(coef);
+				if (str_coef == "0" || str_coef == "-0") return;
+				if (coef > 0 && !src.empty()) src += '+';
+				// unit coefficients are left out in front of X
+				bool const unit = pow > 0 && (str_coef == "1" || str_coef == "-1");
+				src += unit ? str_coef.substr(0, str_coef.size() - 1) : str_coef;
+				if (pow > 0) {
+					src += unit ? "X" : "*X";
+					if (pow > 1) src += "^" + _FunctionInternal::numberToString(pow);
+				}
+			};
+
+			std::string resStr;
+			for (int i = 0; i <= degree; ++i) {
+				continue_polynom_string(resStr, coefficients[i], degree - i);
+			}
+			return resStr.empty() ? "0" : resStr;
+		}
+
+		// From this degree up operator() uses Estrin's scheme; below it Horner's chain is as short.
+		constexpr int EstrinDegree = 8;
+
+		// Estrin's scheme for Count coefficients, highest power first, with powers[j] = x^(2^j):
+		// p = high * x^Half + low, for Half = 2^Level the largest power of two below Count, split
+		// again on both sides, so the chain is about 2 log2(Count) operations deep instead of Count.
+		template <int Count>
+		struct Estrin {
+			static constexpr int Half = Count <= 2 ? 1 : 2 * Estrin<(Count + 1) / 2>::Half;
+			static constexpr int Level = Count <= 2 ? 0 : 1 + Estrin<(Count + 1) / 2>::Level;
+
+			template <typename T>
+			static T apply(T const* coefficients, T const* powers) {
+				using std::fma;
+				return fma(Estrin<Count - Half>::apply(coefficients, powers), powers[Level], Estrin<Half>::apply(coefficients + Count - Half, powers));
+			}
+		};
+
+		template <>
+		struct Estrin<1> {
+			static constexpr int Half = 1;
+			static constexpr int Level = 0;
+
+			template <typename T>
+			static T apply(T const* coefficients, T const*) {
+				return coefficients[0];
+			}
+		};
+
+		// Horner's scheme for count <= EvaluationBlock arguments at once. The coefficients are the
+		// outer loop, so the arguments are independent lanes: the inner loop vectorizes for any
+		// degree and the fma chains of different arguments overlap. Each argument still sees the
+		// roundings of a plain Horner chain.
+		template <typename T>
+		void hornerBlock(T const* coefficients, int degree, T const* args, T* res, int count) {
+			using std::fma;
+			T x[EvaluationBlock], value[EvaluationBlock];
+			for (int i = 0; i < count; ++i) {
+				x[i] = args[i];
+				value[i] = coefficients[0];
+			}
+			for (int j = 1; j <= degree; ++j) {
+				T const coefficient = coefficients[j];
+				for (int i = 0; i < count; ++i) { value[i] = fma(value[i], x[i], coefficient); }
+			}
+			std::copy(value, value + count, res);
+		}
+
+		// hornerBlock over any count, spread over threads for millions of arguments
+		template <typename T>
+		void horner(T const* coefficients, int degree, T const* args, T* res, int count) {
+			auto blocks = [coefficients, degree, args, res](int begin, int end) {
+				for (int start = begin; start < end; start += EvaluationBlock) {
+					hornerBlock(coefficients, degree, args + start, res + start, std::min(EvaluationBlock, end - start));
+				}
+			};
+			int const grain = std::max(EvaluationBlock, parallel::MinWorkPerThread / (degree + 1));
+			// the blocks of Function.h nodes come one by one, and should not ask for threads
+			if (count < 2 * grain) blocks(0, count);
+			else parallel::forRange(count, grain, blocks);
+		}
+
+		// Products of polynomials with a shorter factor of fewer coefficients than this are
+		// computed term by term, longer ones by Karatsuba; from FFTSize coefficients in both
+		// factors by FFT, for floating point types. Both sizes come from timing the three on
+		// doubles, see benchmarks/PolynomialMultiplication.cpp.
+		constexpr int KaratsubaSize = 64;
+		constexpr int FFTSize = 4096;
+
+		// res[k] = sum a[i] * b[k - i] for k < na + nb - 1, in the order PolynomicFunction
+		// always summed, from the last terms down
+		template <typename T>
+		void schoolbook(T const* a, int na, T const* b, int nb, T* res) {
+			std::fill(res, res + na + nb - 1, T());
+			for (int i = na - 1; i >= 0; --i) {
+				for (int j = nb - 1; j >= 0; --j) { res[i + j] += a[i] * b[j]; }
+			}
+		}
+
+		// Equal lengths n: with a = a0 + x^h a1 and b likewise, the middle term comes from one
+		// product (a0 + a1)(b0 + b1) minus the outer two, three products of half the length
+		// instead of four. scratch holds 4n + 64 values.
+		template <typename T>
+		void karatsuba(T const* a, T const* b, int n, T* res, T* scratch) {
+			if (n < KaratsubaSize) {
+				schoolbook(a, n, b, n, res);
+				return;
+			}
+			int const h = n / 2, m = n - h;
+			karatsuba(a, b, h, res, scratch);
+			res[2 * h - 1] = T();
+			karatsuba(a + h, b + h, m, res + 2 * h, scratch);
+
+			T* sumA = scratch;
+			T* sumB = scratch + m;
+			T* middle = scratch + 2 * m;
+			for (int i = 0; i < m; ++i) {
+				sumA[i] = i < h ? a[i] + a[h + i] : a[h + i];
+				sumB[i] = i < h ? b[i] + b[h + i] : b[h + i];
+			}
+			karatsuba(sumA, sumB, m, middle, scratch + 4 * m - 1);
+			for (int i = 0; i < 2 * h - 1; ++i) { middle[i] -= res[i]; }
+			for (int i = 0; i < 2 * m - 1; ++i) { middle[i] -= res[2 * h + i]; }
+			for (int i = 0; i < 2 * m - 1; ++i) { res[h + i] += middle[i]; }
+		}
+
+		// The real sequences a and b travel as one complex one, z = a + i b: the square of its
+		// transform is the transform of a * a - b * b + 2i a * b, so one FFT there and one back
+		// give the product. b is first scaled by a power of two to the size of a, as the error
+		// of every coefficient is about eps * log2(size) * max|a| * max|b| * min(na, nb); a
+		// coefficient far smaller than that keeps only its absolute accuracy.
+		template <typename T>
+		void fftMultiply(T const* a, int na, T const* b, int nb, T* res) {
+			int const count = na + nb - 1;
+			int size = 1;
+			while (size < count) size <<= 1;
+			T maxA = T(), maxB = T();
+			for (int i = 0; i < na; ++i) maxA = std::max(maxA, std::abs(a[i]));
+			for (int i = 0; i < nb; ++i) maxB = std::max(maxB, std::abs(b[i]));
+			if (maxA == T() || maxB == T()) {
+				std::fill(res, res + count, T());
+				return;
+			}
+			int const exponent = std::ilogb(maxA) - std::ilogb(maxB);
+
+			std::vector<std::complex<T>> z(size);
+			for (int i = 0; i < na; ++i) z[i].real(a[i]);
+			for (int i = 0; i < nb; ++i) z[i].imag(std::ldexp(b[i], exponent));
+			fft(z.data(), size);
+			for (auto& value : z) {
+				T const re = value.real(), im = value.imag();
+				value = std::complex<T>(re * re - im * im, T(2) * re * im);
+			}
+			fft(z.data(), size, true);
+			for (int k = 0; k < count; ++k) res[k] = std::ldexp(z[k].imag() / T(2), -exponent);
+		}
+
+		// res = a * b with count na + nb - 1, by the cheapest of the three above. A long factor
+		// is cut into pieces of the length of the short one, for Karatsuba to get equal lengths.
+		template <typename T>
+		void multiply(T const* a, int na, T const* b, int nb, T* res) {
+			if (na < nb) {
+				std::swap(a, b);
+				std::swap(na, nb);
+			}
+			if (nb < KaratsubaSize) {
+				schoolbook(a, na, b, nb, res);
+				return;
+			}
+			if constexpr (std::is_floating_point<T>::value) {
+				if (nb >= FFTSize) {
+					fftMultiply(a, na, b, nb, res);
+					return;
+				}
+			}
+			std::fill(res, res + na + nb - 1, T());
+			std::vector<T> piece(nb), product(2 * nb - 1), scratch(4 * nb + 64);
+			for (int start = 0; start < na; start += nb) {
+				int const len = std::min(nb, na - start);
+				std::copy(a + start, a + start + len, piece.begin());
+				std::fill(piece.begin() + len, piece.end(), T());
+				karatsuba(piece.data(), b, nb, product.data(), scratch.data());
+				for (int k = 0, kn = len + nb - 1; k < kn; ++k) { res[start + k] += product[k]; }
+			}
+		}
+
+	};
+
 	template <int N, typename T>
 	struct PolynomicFunction {
 
 		template <int N2, typename T2>
 		friend struct PolynomicFunction;
 
+		template <typename T2, int InlineCapacity>
+		friend struct Polynomial;
+
 		PolynomicFunction(T const (&coefficients)[N + 1]) {
 			for (int i = 0; i <= N; ++i) { m_coefficients[i] = T(coefficients[i]); }
 		}
 
+		// Horner's chain is N fmas deep; from EstrinDegree up Estrin's scheme shortens it to
+		// about 2 log2(N), at the price of different roundings than evaluate()
 		T operator()(T const& arg) const {
-			T res = m_coefficients[0];
-			for (int i = 1; i <= N; ++i) { res = std::fma(res, arg, m_coefficients[i]); }
+			using namespace _PolynomicFunctionInternal;
+			if constexpr (N >= EstrinDegree) {
+				constexpr int levels = Estrin<N + 1>::Level + 1;
+				T powers[levels] = { arg };
+				for (int j = 1; j < levels; ++j) { powers[j] = powers[j - 1] * powers[j - 1]; }
+				return Estrin<N + 1>::apply(m_coefficients, powers);
+			}
+			else {
+				using std::fma;
+				T res = m_coefficients[0];
+				for (int i = 1; i <= N; ++i) { res = fma(res, arg, m_coefficients[i]); }
+				return res;
+			}
+		}
+
+		// Horner in the element type of arg, e.g. an Interval<T>
+		template <typename Arg, typename = _FunctionInternal::OtherArgument<Arg, T>>
+		Arg operator()(Arg const& arg) const {
+			using std::fma;
+			Arg res = Arg(m_coefficients[0]);
+			for (int i = 1; i <= N; ++i) { res = fma(res, arg, Arg(m_coefficients[i])); }
 			return res;
 		}
 
-		template <int N2>
-		PolynomicFunction<POL_FUNC_POW(N, N2), T> operator*(PolynomicFunction<N2, T> const& other) const {
-			int const newN = POL_FUNC_POW(N, N2);
-			T res_arr[newN + 1] = { T() };
+		// res[i] = (*this)(args[i]) by Horner's scheme over blocks of arguments, see hornerBlock;
+		// the same roundings as operator() below EstrinDegree. args and res may be the same array.
+		void evaluate(T const* args, T* res, int count) const {
+			_PolynomicFunctionInternal::horner(m_coefficients, N, args, res, count);
+		}
 
-			for (int i = N; i >= 0; --i) {
-				for (int j = N2; j >= 0; --j) {
-					res_arr[i + j] += m_coefficients[i] * other.m_coefficients[j];
-				}
+		// d/dX; a constant differentiates to the typed Zero_, so products with it fold away
+		auto derivative() const {
+			if constexpr (N == 0) { return Zero_<T>(); }
+			else {
+				T res_arr[N];
+				for (int i = 0; i < N; ++i) { res_arr[i] = m_coefficients[i] * T(N - i); }
+				return PolynomicFunction<N - 1, T>(res_arr);
 			}
+		}
+
+		// appends the polynomial of the argument to a Tape, see Tape.h
+		template <typename Builder>
+		int emit(Builder& builder) const {
+			return builder.polynomial(builder.argument(), m_coefficients, N);
+		}
 
+		template <int N2>
+		PolynomicFunction<POL_FUNC_POW(N, N2), T> operator*(PolynomicFunction<N2, T> const& other) const {
+			int const newN = POL_FUNC_POW(N, N2);
+			T res_arr[newN + 1];
+			_PolynomicFunctionInternal::multiply(m_coefficients, N + 1, other.m_coefficients, N2 + 1, res_arr);
 			return PolynomicFunction<newN, T>(res_arr);
 		}
 
@@ -84,7 +325,7 @@ namespace bm {
 				for (int i = 0; i < dN; ++i) { res_arr[i] = -other.m_coefficients[i]; }
 			}
 			else {
-				for (int i = 0; i < maxN; ++i) { res_arr[i] = m_coefficients[i] - other.m_coefficients[i]; }
+				for (int i = 0; i <= maxN; ++i) { res_arr[i] = m_coefficients[i] - other.m_coefficients[i]; }
 			}
 
 			return PolynomicFunction<maxN, T>(res_arr);
@@ -107,33 +348,17 @@ namespace bm {
 			return operator+(-sub);
 		}
 
+		PolynomicFunction<N, T> operator-() const {
+			return operator*(T(-1));
+		}
+
 		std::string toString() const {
-			auto to_string_without_trailing_zeros = [](float num) {
-				std::string num_str = std::to_string(num);
-				auto last_not_triling_zero_pos = num_str.find_last_not_of('0');
-				auto erase_start =
-					last_not_triling_zero_pos < num_str.length() && num_str.at(last_not_triling_zero_pos) == '.' ?
-					last_not_triling_zero_pos : last_not_triling_zero_pos + 1;
-				num_str.erase(erase_start, std::string::npos);
-				return num_str;
-			};
-			auto continue_polynom_string = [&to_string_without_trailing_zeros](std::string& src, T const& coef, int pow) {
-				if (!coef) return;
-				auto str_coef = to_string_without_trailing_zeros(coef);
-				if (str_coef == "0") return;// || str_coef == "-0") return;
-				if (coef > 0 && pow != N) src += '+';
-				else if (coef < 0) src += str_coef;
-				if (pow > 0) {
-					src += str_coef == "1" ? "X" : "*X";
-					if (pow > 1) src += "^" + to_string_without_trailing_zeros(pow);
-				}
-			};
+			return _PolynomicFunctionInternal::toString(m_coefficients, N);
+		}
 
-			std::string resStr;
-			for (int i = 0, in = N + 1; i < in; ++i) {
-				continue_polynom_string(resStr, m_coefficients[i], N - i);
-			}
-			return resStr;
+		// the N + 1 coefficients, highest power first
+		T const* coefficients() const {
+			return m_coefficients;
 		}
 
 	private:
@@ -149,6 +374,8 @@ namespace bm {
 	template <typename T>
 	struct X_ : PolynomicFunction<1, T> {
 		X_() : PolynomicFunction<1, T>::PolynomicFunction({ 1, 0 }) { }
+
+		One_<T> derivative() const { return One_<T>(); }
 	};
 
 
@@ -157,12 +384,20 @@ namespace bm {
 		One_() : PolynomicFunction<0, T>::PolynomicFunction({ 1 }) { }
 	};
 
+	template <typename T>
+	struct Zero_ : PolynomicFunction<0, T> {
+		Zero_() : PolynomicFunction<0, T>::PolynomicFunction({ 0 }) { }
+	};
+
 	using Xf = X_<float>;
 	using Xd = X_<double>;
 
 	using Onef = One_<float>;
 	using Oned = One_<double>;
 
+	using Zerof = Zero_<float>;
+	using Zerod = Zero_<double>;
+
 	template <int N, typename ElT = float>
 	PolynomicFunction<(N - 1), ElT> fitPoly(std::array<Vector<2, ElT>, N> const& points) {
 		Matrix<N, N, ElT> coef_mat;
@@ -0,0 +1,178 @@
+#ifndef _BICYCLE_QUATERNION_H_
+#define _BICYCLE_QUATERNION_H_
+
+#include <cmath>
+
+#include "Matrix.h"
+#include "Vector.h"
+
+namespace bm {
+
+	// w + x*i + y*j + z*k. Unit quaternions represent rotations; plain members instead of
+	// Vector<4, T> keep it free of reference members and trivially copyable.
+	template <typename T>
+	struct Quaternion {
+
+		Quaternion() : w(1), x(0), y(0), z(0) { }
+
+		Quaternion(T w, T x, T y, T z) : w(w), x(x), y(y), z(z) { }
+
+		Quaternion(T w, Vector<3, T> const& xyz) : w(w), x(xyz.at(0)), y(xyz.at(1)), z(xyz.at(2)) { }
+
+		// rotation by angle radians around axis, counterclockwise looking against the axis
+		static Quaternion fromAxisAngle(Vector<3, T> const& axis, T angle) {
+			T const halfAngle = angle / 2;
+			return Quaternion(std::cos(halfAngle), axis / axis.norm() * std::sin(halfAngle));
+		}
+
+		// m has to be a rotation matrix; Shepperd's method picks the numerically largest component first
+		static Quaternion fromMatrix(Matrix<3, 3, T> const& m) {
+			T const trace = m.at(0, 0) + m.at(1, 1) + m.at(2, 2);
+			if (trace > m.at(0, 0) && trace > m.at(1, 1) && trace > m.at(2, 2)) {
+				T const s = std::sqrt(trace + 1) * 2;
+				return Quaternion(s / 4, (m.at(2, 1) - m.at(1, 2)) / s, (m.at(0, 2) - m.at(2, 0)) / s, (m.at(1, 0) - m.at(0, 1)) / s);
+			}
+			if (m.at(0, 0) >= m.at(1, 1) && m.at(0, 0) >= m.at(2, 2)) {
+				T const s = std::sqrt(1 + m.at(0, 0) - m.at(1, 1) - m.at(2, 2)) * 2;
+				return Quaternion((m.at(2, 1) - m.at(1, 2)) / s, s / 4, (m.at(0, 1) + m.at(1, 0)) / s, (m.at(0, 2) + m.at(2, 0)) / s);
+			}
+			if (m.at(1, 1) >= m.at(2, 2)) {
+				T const s = std::sqrt(1 + m.at(1, 1) - m.at(0, 0) - m.at(2, 2)) * 2;
+				return Quaternion((m.at(0, 2) - m.at(2, 0)) / s, (m.at(0, 1) + m.at(1, 0)) / s, s / 4, (m.at(1, 2) + m.at(2, 1)) / s);
+			}
+			T const s = std::sqrt(1 + m.at(2, 2) - m.at(0, 0) - m.at(1, 1)) * 2;
+			return Quaternion((m.at(1, 0) - m.at(0, 1)) / s, (m.at(0, 2) + m.at(2, 0)) / s, (m.at(1, 2) + m.at(2, 1)) / s, s / 4);
+		}
+
+		// Hamilton product, applying other first and then this
+		Quaternion operator*(Quaternion const& other) const {
+			return Quaternion(
+				w * other.w - x * other.x - y * other.y - z * other.z,
+				w * other.x + x * other.w + y * other.z - z * other.y,
+				w * other.y - x * other.z + y * other.w + z * other.x,
+				w * other.z + x * other.y - y * other.x + z * other.w
+			);
+		}
+
+		Quaternion operator+(Quaternion const& other) const {
+			return Quaternion(w + other.w, x + other.x, y + other.y, z + other.z);
+		}
+
+		Quaternion operator-(Quaternion const& other) const {
+			return Quaternion(w - other.w, x - other.x, y - other.y, z - other.z);
+		}
+
+		Quaternion operator-() const {
+			return Quaternion(-w, -x, -y, -z);
+		}
+
+		Quaternion operator*(T scale) const {
+			return Quaternion(w * scale, x * scale, y * scale, z * scale);
+		}
+
+		Quaternion operator/(T scale) const {
+			return Quaternion(w / scale, x / scale, y / scale, z / scale);
+		}
+
+		Vector<3, T> xyz() const {
+			return Vector<3, T>(x, y, z);
+		}
+
+		T dot(Quaternion const& other) const {
+			return w * other.w + x * other.x + y * other.y + z * other.z;
+		}
+
+		T norm() const {
+			return std::sqrt(dot(*this));
+		}
+
+		Quaternion normalized() const {
+			return *this / norm();
+		}
+
+		Quaternion conj() const {
+			return Quaternion(w, -x, -y, -z);
+		}
+
+		// equals conj() for unit quaternions
+		Quaternion inv() const {
+			return conj() / dot(*this);
+		}
+
+		Vector<3, T> rotate(Vector<3, T> const& vec) const {
+			Vector<3, T> res;
+			rotate(vec.data(), res.data());
+			return res;
+		}
+
+		// v + 2w(u x v) + 2u x (u x v) with u = (x, y, z); cheaper than q * v * conj(q).
+		// On plain coordinates for the batches of RigidTransform, res may be vec.
+		void rotate(T const* vec, T* res) const {
+			T const tx = 2 * (y * vec[2] - z * vec[1]);
+			T const ty = 2 * (z * vec[0] - x * vec[2]);
+			T const tz = 2 * (x * vec[1] - y * vec[0]);
+			T const rx = vec[0] + w * tx + (y * tz - z * ty);
+			T const ry = vec[1] + w * ty + (z * tx - x * tz);
+			T const rz = vec[2] + w * tz + (x * ty - y * tx);
+			res[0] = rx;
+			res[1] = ry;
+			res[2] = rz;
+		}
+
+		Matrix<3, 3, T> toMatrix() const {
+			T const xx = x * x, yy = y * y, zz = z * z;
+			T const xy = x * y, xz = x * z, yz = y * z;
+			T const wx = w * x, wy = w * y, wz = w * z;
+			return Matrix<3, 3, T>({
+				1 - 2 * (yy + zz), 2 * (xy - wz),	 2 * (xz + wy),
+				2 * (xy + wz),	 1 - 2 * (xx + zz), 2 * (yz - wx),
+				2 * (xz - wy),	 2 * (yz + wx),	 1 - 2 * (xx + yy)
+			});
+		}
+
+		bool operator==(Quaternion const& other) const {
+			return w == other.w && x == other.x && y == other.y && z == other.z;
+		}
+
+		bool operator!=(Quaternion const& other) const {
+			return !(*this == other);
+		}
+
+		T w;
+		T x;
+		T y;
+		T z;
+
+	};
+
+	// Spherical linear interpolation along the shorter arc, constant angular speed in t
+	template <typename T>
+	Quaternion<T> slerp(Quaternion<T> const& from, Quaternion<T> const& to, T t) {
+		T cosAngle = from.dot(to);
+		Quaternion<T> target = to;
+		if (cosAngle < 0) {
+			cosAngle = -cosAngle;
+			target = -to;
+		}
+		// nearly parallel: sin(angle) vanishes, normalized lerp is exact to rounding
+		if (cosAngle > T(1) - T(1e-4)) {
+			return (from * (1 - t) + target * t).normalized();
+		}
+		T const angle = std::acos(cosAngle);
+		T const sinAngle = std::sin(angle);
+		return from * (std::sin((1 - t) * angle) / sinAngle) + target * (std::sin(t * angle) / sinAngle);
+	}
+
+	template <typename T>
+	bool equals(Quaternion<T> const& q1, Quaternion<T> const& q2, T delta = T()) {
+		return
+			std::fabs(q1.w - q2.w) <= delta && std::fabs(q1.x - q2.x) <= delta &&
+			std::fabs(q1.y - q2.y) <= delta && std::fabs(q1.z - q2.z) <= delta;
+	}
+
+	using Quaternionf = Quaternion<float>;
+	using Quaterniond = Quaternion<double>;
+
+}
+
+#endif // !_BICYCLE_QUATERNION_H_
@@ -0,0 +1,288 @@
+#ifndef _BICYCLE_RANDOM_H_
+#define _BICYCLE_RANDOM_H_
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#include "DynamicMatrix.h"
+#include "DynamicVector.h"
+#include "Matrix.h"
+#include "Parallel.h"
+#include "Point.h"
+#include "Simd.h"
+#include "SimdMath.h"
+#include "Vector.h"
+
+namespace bm {
+
+	namespace random {
+
+		namespace _RandomInternal {
+
+			// Philox4x32-10 (Salmon et al., "Parallel random numbers: as easy as 1, 2, 3"):
+			// 128 random bits as a pure function of a 64 bit key and a 128 bit counter.
+			struct Block {
+				std::uint32_t words[4];
+			};
+
+			inline Block philox(std::uint64_t key, std::uint64_t counterHigh, std::uint64_t counterLow) {
+				std::uint32_t c0 = static_cast<std::uint32_t>(counterLow), c1 = static_cast<std::uint32_t>(counterLow >> 32);
+				std::uint32_t c2 = static_cast<std::uint32_t>(counterHigh), c3 = static_cast<std::uint32_t>(counterHigh >> 32);
+				std::uint32_t k0 = static_cast<std::uint32_t>(key), k1 = static_cast<std::uint32_t>(key >> 32);
+				for (int round = 0; round < 10; ++round) {
+					std::uint64_t const p0 = std::uint64_t(0xD2511F53u) * c0;
+					std::uint64_t const p1 = std::uint64_t(0xCD9E8D57u) * c2;
+					std::uint32_t const n0 = static_cast<std::uint32_t>(p1 >> 32) ^ c1 ^ k0;
+					std::uint32_t const n2 = static_cast<std::uint32_t>(p0 >> 32) ^ c3 ^ k1;
+					c1 = static_cast<std::uint32_t>(p1);
+					c3 = static_cast<std::uint32_t>(p0);
+					c0 = n0;
+					c2 = n2;
+					k0 += 0x9E3779B9u;
+					k1 += 0xBB67AE85u;
+				}
+				return Block{ { c0, c1, c2, c3 } };
+			}
+
+			// Turns one block into random values of W: four for types up to 32 bits, two for wider ones.
+			template <typename W, bool Floating = std::is_floating_point<W>::value>
+			struct Draw {
+
+				static constexpr int perBlock = sizeof(W) > 4 ? 2 : 4;
+
+				// [0, 1) for the low flag, (0, 1] otherwise, so the result can go into log
+				static W unit(Block const& block, int i, bool low = true) {
+					if constexpr (perBlock == 4) {
+						return W((block.words[i] >> 8) + (low ? 0u : 1u)) * W(1.0 / (1 << 24));
+					}
+					else {
+						std::uint64_t const bits = (std::uint64_t(block.words[2 * i]) << 32 | block.words[2 * i + 1]) >> 11;
+						return W(bits + (low ? 0u : 1u)) * W(1.0 / (std::uint64_t(1) << 53));
+					}
+				}
+
+				static void uniform(Block const* blocks, int count, W* values, W min, W max) {
+					for (int b = 0; b < count; ++b) {
+						for (int i = 0; i < perBlock; ++i) values[b * perBlock + i] = min + (max - min) * unit(blocks[b], i);
+					}
+				}
+
+				// Box-Muller: every pair of uniforms gives two independent normals. The uniforms of all
+				// count blocks are drawn first, log, cos and sin then run over whole arrays (SimdMath.h).
+				static void normal(Block const* blocks, int count, W* values, W mean, W stddev) {
+					W const twoPi = W(6.283185307179586476925286766559);
+					int const pairs = count * perBlock / 2;
+					assert(pairs <= simd::MathBlock);
+					W radius[simd::MathBlock] = {}, angle[simd::MathBlock] = {}, cosine[simd::MathBlock];
+					for (int i = 0; i < pairs; ++i) {
+						Block const& block = blocks[2 * i / perBlock];
+						radius[i] = unit(block, 2 * i % perBlock, false);
+						angle[i] = twoPi * unit(block, 2 * i % perBlock + 1);
+					}
+					simd::log(radius, radius, pairs);
+					for (int i = 0; i < pairs; ++i) radius[i] = std::sqrt(W(-2) * radius[i]) * stddev;
+					simd::cos(angle, cosine, pairs);
+					simd::sin(angle, angle, pairs);
+					for (int i = 0; i < pairs; ++i) {
+						values[2 * i] = mean + radius[i] * cosine[i];
+						values[2 * i + 1] = mean + radius[i] * angle[i];
+					}
+				}
+			};
+
+			template <typename W>
+			struct Draw<W, false> {
+
+				static constexpr int perBlock = sizeof(W) > 4 ? 2 : 4;
+
+				// [min, max] for ranges up to 2^32 by a multiply and shift; the bias of at most range / 2^32 is ignored
+				static void uniform(Block const* blocks, int count, W* values, W min, W max) {
+					std::uint64_t const range = static_cast<std::uint64_t>(static_cast<std::int64_t>(max) - static_cast<std::int64_t>(min)) + 1;
+					for (int b = 0; b < count; ++b) {
+						for (int i = 0; i < perBlock; ++i) {
+							std::uint64_t const bits = perBlock == 4 ? blocks[b].words[i] : blocks[b].words[2 * i];
+							values[b * perBlock + i] = static_cast<W>(static_cast<std::int64_t>(min) + static_cast<std::int64_t>((bits * range) >> 32));
+						}
+					}
+				}
+			};
+
+			// How the random module reaches the elements of a fillable type.
+			template <typename Fillable>
+			struct Target;
+
+			template <int Len, typename T>
+			struct Target<Vector<Len, T>> {
+				using Scalar = T;
+				static int size(Vector<Len, T> const&) { return Len; }
+				static T& at(Vector<Len, T>& vec, int i) { return vec[i]; }
+			};
+
+			template <int Len, typename T>
+			struct Target<Point<Len, T>> {
+				using Scalar = T;
+				static int size(Point<Len, T> const&) { return Len; }
+				static T& at(Point<Len, T>& point, int i) { return point[i]; }
+			};
+
+			template <int Rows, int Cols, typename T>
+			struct Target<Matrix<Rows, Cols, T>> {
+				using Scalar = T;
+				static int size(Matrix<Rows, Cols, T> const&) { return Rows * Cols; }
+				static T& at(Matrix<Rows, Cols, T>& mat, int i) { return mat.at(i / Cols, i % Cols); }
+			};
+
+			template <typename T, int InlineCapacity>
+			struct Target<DynamicVector<T, InlineCapacity>> {
+				using Scalar = T;
+				static int size(DynamicVector<T, InlineCapacity> const& vec) { return vec.size(); }
+				static T& at(DynamicVector<T, InlineCapacity>& vec, int i) { return vec[i]; }
+			};
+
+			template <typename T>
+			struct Target<DynamicMatrix<T>> {
+				using Scalar = T;
+				static int size(DynamicMatrix<T> const& mat) { return mat.rows() * mat.cols(); }
+				static T& at(DynamicMatrix<T>& mat, int i) { return mat.at(i / mat.cols(), i % mat.cols()); }
+			};
+
+		};
+
+		// Counter based generator. Value i of a batch comes from block i / perBlock of the counter, so a batch
+		// is filled by any number of threads with the same result, and a seed (plus stream) always gives
+		// the same sequence. Every call continues where the previous one stopped.
+		// Also a UniformRandomBitGenerator for the std distributions.
+		class Generator {
+
+			template <typename T>
+			using Compute = typename ScalarTraits<T>::Compute;
+
+		public:
+
+			using result_type = std::uint32_t;
+
+			// generators with the same seed and different streams are independent
+			explicit Generator(std::uint64_t seed = 0, std::uint64_t stream = 0)
+				: m_key(seed), m_stream(stream), m_counter(0), m_used(4), m_block() { }
+
+			static constexpr result_type min() {
+				return 0;
+			}
+
+			static constexpr result_type max() {
+				return std::numeric_limits<result_type>::max();
+			}
+
+			result_type operator()() {
+				if (m_used == 4) {
+					m_block = _RandomInternal::philox(m_key, m_stream, m_counter++);
+					m_used = 0;
+				}
+				return m_block.words[m_used++];
+			}
+
+			// blocks consumed so far; batches start on a fresh block
+			std::uint64_t position() const {
+				return m_counter;
+			}
+
+			// floating point values in [min, max), integers in [min, max]
+			template <typename T>
+			void uniform(T* values, int count, T min = T(0), T max = T(1)) {
+				using W = Compute<T>;
+				generate<W>(count, [min, max](_RandomInternal::Block const* blocks, int n, W* res) {
+					_RandomInternal::Draw<W>::uniform(blocks, n, res, W(min), W(max));
+				}, [values](int i, W value) { values[i] = T(value); });
+			}
+
+			template <typename T>
+			void normal(T* values, int count, T mean = T(0), T stddev = T(1)) {
+				using W = Compute<T>;
+				static_assert(std::is_floating_point<W>::value, "Normal values need a floating point type.");
+				generate<W>(count, [mean, stddev](_RandomInternal::Block const* blocks, int n, W* res) {
+					_RandomInternal::Draw<W>::normal(blocks, n, res, W(mean), W(stddev));
+				}, [values](int i, W value) { values[i] = T(value); });
+			}
+
+			// Vector, Point, Matrix, DynamicVector or DynamicMatrix
+			template <typename Fillable, typename T = typename _RandomInternal::Target<Fillable>::Scalar>
+			Fillable& uniform(Fillable& target, T min = T(0), T max = T(1)) {
+				using Scalar = typename _RandomInternal::Target<Fillable>::Scalar;
+				using W = Compute<Scalar>;
+				generate<W>(_RandomInternal::Target<Fillable>::size(target), [min, max](_RandomInternal::Block const* blocks, int n, W* res) {
+					_RandomInternal::Draw<W>::uniform(blocks, n, res, W(min), W(max));
+				}, [&target](int i, W value) { _RandomInternal::Target<Fillable>::at(target, i) = Scalar(value); });
+				return target;
+			}
+
+			template <typename Fillable, typename T = typename _RandomInternal::Target<Fillable>::Scalar>
+			Fillable& normal(Fillable& target, T mean = T(0), T stddev = T(1)) {
+				using Scalar = typename _RandomInternal::Target<Fillable>::Scalar;
+				using W = Compute<Scalar>;
+				static_assert(std::is_floating_point<W>::value, "Normal values need a floating point type.");
+				generate<W>(_RandomInternal::Target<Fillable>::size(target), [mean, stddev](_RandomInternal::Block const* blocks, int n, W* res) {
+					_RandomInternal::Draw<W>::normal(blocks, n, res, W(mean), W(stddev));
+				}, [&target](int i, W value) { _RandomInternal::Target<Fillable>::at(target, i) = Scalar(value); });
+				return target;
+			}
+
+			// batches of vectors or points, filled as one long sequence
+			template <template <int, typename> class Fixed, int Len, typename T>
+			void uniform(Fixed<Len, T>* batch, int count, T min = T(0), T max = T(1)) {
+				using W = Compute<T>;
+				generate<W>(count * Len, [min, max](_RandomInternal::Block const* blocks, int n, W* res) {
+					_RandomInternal::Draw<W>::uniform(blocks, n, res, W(min), W(max));
+				}, [batch](int i, W value) { batch[i / Len][i % Len] = T(value); });
+			}
+
+			template <template <int, typename> class Fixed, int Len, typename T>
+			void normal(Fixed<Len, T>* batch, int count, T mean = T(0), T stddev = T(1)) {
+				using W = Compute<T>;
+				static_assert(std::is_floating_point<W>::value, "Normal values need a floating point type.");
+				generate<W>(count * Len, [mean, stddev](_RandomInternal::Block const* blocks, int n, W* res) {
+					_RandomInternal::Draw<W>::normal(blocks, n, res, W(mean), W(stddev));
+				}, [batch](int i, W value) { batch[i / Len][i % Len] = T(value); });
+			}
+
+		private:
+
+			// draw(blocks, n, values) makes n * perBlock values out of n consecutive blocks, at most a group
+			// of them, store(i, value) puts value i in place
+			template <typename W, typename DrawBlocks, typename Store>
+			void generate(int count, DrawBlocks const& draw, Store const& store) {
+				static constexpr int perBlock = _RandomInternal::Draw<W>::perBlock;
+				static constexpr int group = simd::MathBlock / perBlock;
+				int const blocks = (count + perBlock - 1) / perBlock;
+				std::uint64_t const key = m_key, stream = m_stream, first = m_counter;
+				m_counter += blocks;
+				m_used = 4;
+				parallel::forRange(blocks, parallel::MinWorkPerThread / perBlock, [&draw, &store, key, stream, first, count](int begin, int end) {
+					for (int b = begin; b < end; b += group) {
+						int const n = std::min(group, end - b);
+						_RandomInternal::Block blocks[group];
+						for (int k = 0; k < n; ++k) blocks[k] = _RandomInternal::philox(key, stream, first + b + k);
+						W values[simd::MathBlock];
+						draw(blocks, n, values);
+						int const valuesInGroup = std::min(n * perBlock, count - b * perBlock);
+						for (int j = 0; j < valuesInGroup; ++j) store(b * perBlock + j, values[j]);
+					}
+				});
+			}
+
+			std::uint64_t m_key;
+			std::uint64_t m_stream;
+			std::uint64_t m_counter;
+			int m_used;
+			_RandomInternal::Block m_block;
+
+		};
+
+	}
+
+}
+
+#endif // !_BICYCLE_RANDOM_H_
@@ -1,6 +1,7 @@
 #ifndef _BICYCLE_RATIONAL_FUNCTION_H_
 #define _BICYCLE_RATIONAL_FUNCTION_H_
 
+#include <algorithm>
 #include <array>
 #include "Vector.h"
 #include "Matrix.h"
@@ -38,6 +39,22 @@ namespace bm {
 			return m_numerator(parameter) / m_denominator(parameter);
 		}
 
+		template <typename Arg, typename = _FunctionInternal::OtherArgument<Arg, T>>
+		Arg operator()(Arg const& parameter) const {
+			return m_numerator(parameter) / m_denominator(parameter);
+		}
+
+		// res[i] = (*this)(args[i]); args and res may be the same array
+		void evaluate(T const* args, T* res, int count) const {
+			for (int start = 0; start < count; start += EvaluationBlock) {
+				int const len = std::min(EvaluationBlock, count - start);
+				T denominator[EvaluationBlock];
+				m_denominator.evaluate(args + start, denominator, len);
+				m_numerator.evaluate(args + start, res + start, len);
+				for (int i = 0; i < len; ++i) { res[start + i] /= denominator[i]; }
+			}
+		}
+
 		#define RATIONAL_FUNCTION_MULTIPLICATION_RES_T RationalFunction<T, POL_FUNC_POW(NUMERATOR, NUMERATOR_2), POL_FUNC_POW(DENOMINATOR, DENOMINATOR_2)>
 		#define RATIONAL_FUNCTION_DIVISION_RES_T RationalFunction<T, POL_FUNC_POW(NUMERATOR, DENOMINATOR_2), POL_FUNC_POW(DENOMINATOR, NUMERATOR_2)>
 		#define RATIONAL_FUNCTION_ADDITION_RES_T RationalFunction<T, MAX(POL_FUNC_POW(NUMERATOR, DENOMINATOR_2), POL_FUNC_POW(NUMERATOR_2, DENOMINATOR)), POL_FUNC_POW(DENOMINATOR_2, DENOMINATOR)>
@@ -97,6 +114,14 @@ namespace bm {
 				denominatorString;
 		}
 
+		PolynomicFunction<NUMERATOR, T> const& numerator() const {
+			return m_numerator;
+		}
+
+		PolynomicFunction<DENOMINATOR, T> const& denominator() const {
+			return m_denominator;
+		}
+
 	private:
 
 		PolynomicFunction<NUMERATOR, T> m_numerator;
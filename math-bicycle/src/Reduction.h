@@ -0,0 +1,223 @@
+#ifndef _BICYCLE_REDUCTION_H_
+#define _BICYCLE_REDUCTION_H_
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include "Parallel.h"
+#include "Simd.h"
+
+namespace bm {
+
+	// How a sum of many terms is accumulated. All modes except Parallel are deterministic for a given
+	// length: the order of additions depends only on n, never on data, timing or the number of threads.
+	enum class Reduction {
+		// one running sum, error grows as O(n); the dependency chain blocks vectorization
+		Sequential,
+		// independent partial sums combined at the end, vectorizes; error as Sequential
+		MultiAccumulator,
+		// recursive halving over multi-accumulator blocks, error grows as O(log n)
+		Pairwise,
+		// Neumaier compensated summation, error independent of n while n * epsilon stays well below 1,
+		// about 4x the work of Sequential
+		Compensated,
+		// MultiAccumulator over one contiguous chunk per thread. The fastest mode for long vectors,
+		// but the chunk borders move with parallel::threadCount(), and so do the last bits of the result
+		Parallel,
+		// Pairwise over fixed ReproducibleBlock sized blocks spread over threads, block sums combined by
+		// a fixed pairwise tree: bitwise identical results across runs and thread counts.
+		// Costs one partial sum per block and the pairwise recursion: on one core about 1.2-1.5x the time
+		// of Parallel when the data is in cache and within 20% of it when memory bandwidth is the limit
+		Reproducible
+	};
+
+	namespace simd {
+
+		// enough partial sums to fill a 256 bit register of floats or two of doubles
+		constexpr int ReductionAccumulators = 8;
+
+		// below this length Pairwise stops splitting
+		constexpr int PairwiseBlock = 256;
+
+		// unit of work of Reproducible, independent of the number of threads
+		constexpr int ReproducibleBlock = 4096;
+
+		// Neumaier's variant of Kahan summation, also correct when a term is larger than the sum.
+		// Relies on strict IEEE evaluation, do not build with -ffast-math.
+		template <typename T>
+		struct CompensatedSum {
+
+			void add(T const value) {
+				T const t = sum + value;
+				compensation += std::fabs(sum) >= std::fabs(value) ? (sum - t) + value : (value - t) + sum;
+				sum = t;
+			}
+
+			// an infinite sum turns the compensation into NaN, the sum itself is the answer then
+			T value() const {
+				return std::isfinite(sum) ? sum + compensation : sum;
+			}
+
+			T sum = T();
+			T compensation = T();
+		};
+
+		template <typename T, typename Term>
+		T multiAccumulatorSum(Term const& term, int begin, int end) {
+			T acc[ReductionAccumulators] = { T() };
+			int i = begin;
+			for (; i + ReductionAccumulators <= end; i += ReductionAccumulators) {
+				for (int j = 0; j < ReductionAccumulators; ++j) acc[j] = acc[j] + term(i + j);
+			}
+			for (int j = 0; i < end; ++i, ++j) acc[j] = acc[j] + term(i);
+			for (int width = ReductionAccumulators / 2; width > 0; width /= 2) {
+				for (int j = 0; j < width; ++j) acc[j] = acc[j] + acc[j + width];
+			}
+			return acc[0];
+		}
+
+		template <typename T, typename Term>
+		T pairwiseSum(Term const& term, int begin, int end) {
+			if (end - begin <= PairwiseBlock) return multiAccumulatorSum<T>(term, begin, end);
+			int const middle = begin + (end - begin) / 2;
+			return pairwiseSum<T>(term, begin, middle) + pairwiseSum<T>(term, middle, end);
+		}
+
+		template <typename T, typename Term>
+		T parallelSum(Term const& term, int n) {
+			int const chunks = std::min(parallel::threadCount(), n / parallel::MinWorkPerThread);
+			if (chunks <= 1) return multiAccumulatorSum<T>(term, 0, n);
+			std::vector<T> partialSums(chunks);
+			parallel::forChunks(chunks, n, [&term, &partialSums](int chunk, int begin, int end) {
+				partialSums[chunk] = multiAccumulatorSum<T>(term, begin, end);
+			});
+			T res = T();
+			for (auto const& partialSum : partialSums) res = res + partialSum;
+			return res;
+		}
+
+		template <typename T, typename Term>
+		T reproducibleSum(Term const& term, int n) {
+			int const blocks = (n + ReproducibleBlock - 1) / ReproducibleBlock;
+			if (blocks <= 1) return pairwiseSum<T>(term, 0, n);
+			std::vector<T> blockSums(blocks);
+			int const blocksPerThread = std::max(1, parallel::MinWorkPerThread / ReproducibleBlock);
+			parallel::forRange(blocks, blocksPerThread, [&term, &blockSums, n](int begin, int end) {
+				for (int block = begin; block < end; ++block) {
+					blockSums[block] = pairwiseSum<T>(term, block * ReproducibleBlock, std::min(n, (block + 1) * ReproducibleBlock));
+				}
+			});
+			T const* blockSumsData = blockSums.data();
+			return pairwiseSum<T>([blockSumsData](int block) { return blockSumsData[block]; }, 0, blocks);
+		}
+
+		// sum of term(i) for i in [0, n); Parallel and Reproducible call term from several threads
+		template <Reduction Mode, typename T, typename Term>
+		T reduce(Term const& term, int n) {
+			if constexpr (Mode == Reduction::Parallel) {
+				return parallelSum<T>(term, n);
+			}
+			else if constexpr (Mode == Reduction::Reproducible) {
+				return reproducibleSum<T>(term, n);
+			}
+			else if constexpr (Mode == Reduction::MultiAccumulator) {
+				return multiAccumulatorSum<T>(term, 0, n);
+			}
+			else if constexpr (Mode == Reduction::Pairwise) {
+				return pairwiseSum<T>(term, 0, n);
+			}
+			else if constexpr (Mode == Reduction::Compensated && std::is_floating_point<T>::value) {
+				CompensatedSum<T> res;
+				for (int i = 0; i < n; ++i) res.add(term(i));
+				return res.value();
+			}
+			else {
+				T res = T();
+				for (int i = 0; i < n; ++i) res = res + term(i);
+				return res;
+			}
+		}
+
+		// Compact element types are widened to ScalarTraits<T>::Compute before they are multiplied and summed.
+		template <Reduction Mode = Reduction::Sequential, typename T>
+		auto dot(T const* x, T const* y, int n) {
+			using W = typename ScalarTraits<T>::Compute;
+			if constexpr (Mode == Reduction::Sequential) {
+				using std::fma;
+				W res = W();
+				for (int i = 0; i < n; ++i) res = fma(W(x[i]), W(y[i]), res);
+				return res;
+			}
+			else if constexpr (Mode == Reduction::Compensated && std::is_floating_point<W>::value) {
+				// fma recovers the rounding error of every product, so it is compensated as well
+				CompensatedSum<W> res;
+				for (int i = 0; i < n; ++i) {
+					W const product = W(x[i]) * W(y[i]);
+					res.add(product);
+					res.compensation += std::fma(W(x[i]), W(y[i]), -product);
+				}
+				return res.value();
+			}
+			else {
+				return reduce<Mode, W>([x, y](int i) { return W(x[i]) * W(y[i]); }, n);
+			}
+		}
+
+		// Euclidean norm. Floating point sums of squares that overflow or underflow are
+		// recomputed on values scaled by the largest magnitude, the way hypot does it.
+		template <Reduction Mode = Reduction::Sequential, typename T>
+		auto norm(T const* x, int n) {
+			using W = typename ScalarTraits<T>::Compute;
+			W const squaresSum = reduce<Mode, W>([x](int i) { return W(x[i]) * W(x[i]); }, n);
+			if constexpr (std::is_floating_point<W>::value) {
+				if (std::isnan(squaresSum) || (std::isfinite(squaresSum) && squaresSum >= std::numeric_limits<W>::min())) {
+					return std::sqrt(squaresSum);
+				}
+				W maxAbs = W();
+				for (int i = 0; i < n; ++i) maxAbs = std::fmax(maxAbs, std::fabs(W(x[i])));
+				if (maxAbs == W() || std::isinf(maxAbs)) return maxAbs;
+				W const scaledSum = reduce<Mode, W>([x, maxAbs](int i) { W const scaled = W(x[i]) / maxAbs; return scaled * scaled; }, n);
+				return maxAbs * std::sqrt(scaledSum);
+			}
+			else {
+				using std::sqrt;
+				return sqrt(squaresSum);
+			}
+		}
+
+		// Smallest and largest of x[0, n) in one pass. Partial results per lane keep the loop branch free,
+		// `v < lo ? v : lo` is exactly what packed min instructions compute, NaNs are skipped.
+		// Without any other value min stays numeric_limits<T>::max() and max numeric_limits<T>::lowest().
+		template <typename T>
+		void minMax(T const* x, int n, T& min, T& max) {
+			T lo[ReductionAccumulators], hi[ReductionAccumulators];
+			std::fill(lo, lo + ReductionAccumulators, std::numeric_limits<T>::max());
+			std::fill(hi, hi + ReductionAccumulators, std::numeric_limits<T>::lowest());
+			int i = 0;
+			for (; i + ReductionAccumulators <= n; i += ReductionAccumulators) {
+				for (int j = 0; j < ReductionAccumulators; ++j) {
+					T const value = x[i + j];
+					lo[j] = value < lo[j] ? value : lo[j];
+					hi[j] = hi[j] < value ? value : hi[j];
+				}
+			}
+			for (int j = 0; i < n; ++i, ++j) {
+				lo[j] = x[i] < lo[j] ? x[i] : lo[j];
+				hi[j] = hi[j] < x[i] ? x[i] : hi[j];
+			}
+			min = lo[0];
+			max = hi[0];
+			for (int j = 1; j < ReductionAccumulators; ++j) {
+				min = lo[j] < min ? lo[j] : min;
+				max = max < hi[j] ? hi[j] : max;
+			}
+		}
+
+	}
+
+}
+
+#endif // !_BICYCLE_REDUCTION_H_
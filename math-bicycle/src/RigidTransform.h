@@ -0,0 +1,152 @@
+#ifndef _BICYCLE_RIGID_TRANSFORM_H_
+#define _BICYCLE_RIGID_TRANSFORM_H_
+
+#include <cassert>
+#include <cmath>
+
+#include "Matrix.h"
+#include "Point.h"
+#include "Quaternion.h"
+#include "Vector.h"
+
+namespace bm {
+
+	// Rotation followed by translation, p -> rotation.rotate(p) + translation.
+	// Composition takes 28 multiplications instead of a 64 multiplication GEMM.
+	template <typename T>
+	struct RigidTransform {
+
+		RigidTransform() : rotation(), translation() { }
+
+		RigidTransform(Quaternion<T> const& rotation, Vector<3, T> const& translation = Vector<3, T>())
+			: rotation(rotation), translation(translation) { }
+
+		// the upper left 3x3 block of mat has to be a rotation and the last row (0, 0, 0, 1)
+		explicit RigidTransform(Matrix<4, 4, T> const& mat)
+			: rotation(Quaternion<T>::fromMatrix(Matrix<3, 3, T>({
+				mat.at(0, 0), mat.at(0, 1), mat.at(0, 2),
+				mat.at(1, 0), mat.at(1, 1), mat.at(1, 2),
+				mat.at(2, 0), mat.at(2, 1), mat.at(2, 2)
+			}))),
+			translation(mat.at(0, 3), mat.at(1, 3), mat.at(2, 3)) { }
+
+		RigidTransform(RigidTransform const& other) : rotation(other.rotation), translation(other.translation) { }
+
+		RigidTransform& operator=(RigidTransform const& other) {
+			rotation = other.rotation;
+			translation = other.translation;
+			return *this;
+		}
+
+		Matrix<4, 4, T> toMatrix() const {
+			Matrix<3, 3, T> const r = rotation.toMatrix();
+			return Matrix<4, 4, T>({
+				r.at(0, 0), r.at(0, 1), r.at(0, 2), translation.at(0),
+				r.at(1, 0), r.at(1, 1), r.at(1, 2), translation.at(1),
+				r.at(2, 0), r.at(2, 1), r.at(2, 2), translation.at(2),
+				T(0),		T(0),		T(0),		T(1)
+			});
+		}
+
+		// applies other first and then this, like the product of their matrices
+		RigidTransform operator*(RigidTransform const& other) const {
+			return RigidTransform(rotation * other.rotation, rotation.rotate(other.translation) + translation);
+		}
+
+		RigidTransform inv() const {
+			Quaternion<T> const invRotation = rotation.conj();
+			return RigidTransform(invRotation, invRotation.rotate(translation) * T(-1));
+		}
+
+		Point<3, T> operator*(Point<3, T> const& point) const {
+			Vector<3, T> const moved = rotation.rotate(Vector<3, T>(point.x, point.y, point.z)) + translation;
+			return Point<3, T>(moved.x, moved.y, moved.z);
+		}
+
+		// directions are not translated
+		Vector<3, T> operator*(Vector<3, T> const& vec) const {
+			return rotation.rotate(vec);
+		}
+
+		// Transforms count points at once. The rotation is expanded to a matrix a single time,
+		// after that every point costs 9 multiplications instead of the 15 of a quaternion rotation.
+		void transform(Point<3, T> const* points, Point<3, T>* result, int count) const {
+			assert(count >= 0);
+			Matrix<3, 3, T> const r = rotation.toMatrix();
+			T const m[9] = {
+				r.at(0, 0), r.at(0, 1), r.at(0, 2),
+				r.at(1, 0), r.at(1, 1), r.at(1, 2),
+				r.at(2, 0), r.at(2, 1), r.at(2, 2)
+			};
+			T const tx = translation.at(0), ty = translation.at(1), tz = translation.at(2);
+			for (int i = 0; i < count; ++i) {
+				T const x = points[i].at(0), y = points[i].at(1), z = points[i].at(2);
+				result[i][0] = m[0] * x + m[1] * y + m[2] * z + tx;
+				result[i][1] = m[3] * x + m[4] * y + m[5] * z + ty;
+				result[i][2] = m[6] * x + m[7] * y + m[8] * z + tz;
+			}
+		}
+
+		bool operator==(RigidTransform const& other) const {
+			return rotation == other.rotation && translation == other.translation;
+		}
+
+		bool operator!=(RigidTransform const& other) const {
+			return !(*this == other);
+		}
+
+		Quaternion<T> rotation;
+		Vector<3, T> translation;
+
+	};
+
+	// slerp of the rotations and linear interpolation of the translations
+	template <typename T>
+	RigidTransform<T> interpolate(RigidTransform<T> const& from, RigidTransform<T> const& to, T t) {
+		return RigidTransform<T>(
+			slerp(from.rotation, to.rotation, t),
+			from.translation + (to.translation - from.translation) * t
+		);
+	}
+
+	// result[i] = lhs[i] * rhs[i] for count pairs, e.g. parent and local transforms of a skeleton.
+	// Every pair is read before its result is written, so result may be lhs or rhs.
+	template <typename T>
+	void compose(RigidTransform<T> const* lhs, RigidTransform<T> const* rhs, RigidTransform<T>* result, int count) {
+		assert(count >= 0);
+		for (int i = 0; i < count; ++i) {
+			Quaternion<T> const a = lhs[i].rotation, b = rhs[i].rotation;
+			T const translation[3] = { rhs[i].translation.at(0), rhs[i].translation.at(1), rhs[i].translation.at(2) };
+			T const offset[3] = { lhs[i].translation.at(0), lhs[i].translation.at(1), lhs[i].translation.at(2) };
+			T moved[3];
+			a.rotate(translation, moved);
+			result[i].rotation = a * b;
+			for (int k = 0; k < 3; ++k) result[i].translation[k] = moved[k] + offset[k];
+		}
+	}
+
+	// result[i] = transforms[i] * points[i], one transform per point
+	template <typename T>
+	void transform(RigidTransform<T> const* transforms, Point<3, T> const* points, Point<3, T>* result, int count) {
+		assert(count >= 0);
+		for (int i = 0; i < count; ++i) {
+			T const point[3] = { points[i].at(0), points[i].at(1), points[i].at(2) };
+			T moved[3];
+			transforms[i].rotation.rotate(point, moved);
+			for (int k = 0; k < 3; ++k) result[i][k] = moved[k] + transforms[i].translation.at(k);
+		}
+	}
+
+	template <typename T>
+	bool equals(RigidTransform<T> const& transform1, RigidTransform<T> const& transform2, T delta = T()) {
+		return
+			equals(transform1.rotation, transform2.rotation, delta) &&
+			equals(transform1.translation, transform2.translation, delta);
+	}
+
+	using RigidTransformf = RigidTransform<float>;
+	using RigidTransformd = RigidTransform<double>;
+
+}
+
+#endif // !_BICYCLE_RIGID_TRANSFORM_H_
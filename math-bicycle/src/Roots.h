@@ -0,0 +1,325 @@
+#ifndef _BICYCLE_ROOTS_H_
+#define _BICYCLE_ROOTS_H_
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <complex>
+#include <limits>
+#include <vector>
+
+#include "Parallel.h"
+#include "Polynomial.h"
+#include "PolynomicFunction.h"
+#include "RationalFunction.h"
+
+namespace bm {
+
+	namespace _RootsInternal {
+
+		// Aberth sweeps before giving up; simple roots converge cubically, so a few suffice
+		constexpr int MaxIterations = 100;
+
+		template <typename T>
+		constexpr T pi = T(3.14159265358979323846);
+
+		// T values a Sturm sequence of the given degree needs, see sturm()
+		constexpr int sturmStorage(int degree) {
+			return (degree + 1) * (degree + 2) / 2 + degree + 1;
+		}
+
+		// All n roots of c[0] x^n + ... + c[n] with c[0] and c[n] not 0, by Aberth-Ehrlich:
+		// Newton's step for each approximation z_k, corrected for the pull of all the others,
+		// 1 / (p'(z_k) / p(z_k) - sum 1 / (z_k - z_j)). Updates are used by the next root in the
+		// same sweep. A root is done once |p(z_k)| is within the rounding error of evaluating
+		// p there, which also stops multiple roots, where the steps slow down to linear.
+		template <typename T>
+		bool aberth(T const* c, int n, std::complex<T>* z) {
+			using Complex = std::complex<T>;
+			if (n == 1) {
+				z[0] = Complex(-c[1] / c[0]);
+				return true;
+			}
+			// on a circle of the geometric mean of the root magnitudes; the angle offset keeps
+			// the starting points off the real axis, where real polynomials are symmetric
+			T const radius = std::pow(std::abs(c[n] / c[0]), T(1) / T(n));
+			for (int k = 0; k < n; ++k) z[k] = std::polar(radius, T(2) * pi<T> * T(k) / T(n) + T(0.4));
+
+			T const tolerance = T(4 * n) * std::numeric_limits<T>::epsilon();
+			for (int iteration = 0; iteration < MaxIterations; ++iteration) {
+				bool done = true;
+				for (int k = 0; k < n; ++k) {
+					Complex const x = z[k];
+					T const r = std::abs(x);
+					Complex value = c[0], derivative = T();
+					T bound = std::abs(c[0]);
+					for (int i = 1; i <= n; ++i) {
+						derivative = derivative * x + value;
+						value = value * x + c[i];
+						bound = bound * r + std::abs(c[i]);
+					}
+					if (std::abs(value) <= tolerance * bound) continue;
+					done = false;
+					Complex pull = T();
+					for (int j = 0; j < n; ++j) {
+						if (j != k) pull += T(1) / (x - z[j]);
+					}
+					z[k] = x - T(1) / (derivative / value - pull);
+				}
+				if (done) return true;
+			}
+			return false;
+		}
+
+		// Exact zero roots are split off first, and leading zero coefficients lower the degree.
+		// Returns the true degree, the number of roots written.
+		template <typename T>
+		int roots(T const* coefficients, int degree, std::complex<T>* res, bool& converged) {
+			assert(degree >= 0);
+			int first = 0;
+			while (first < degree && coefficients[first] == T()) ++first;
+			T const* c = coefficients + first;
+			int const n = degree - first;
+			int zeros = 0;
+			while (zeros < n && c[n - zeros] == T()) ++zeros;
+			for (int k = 0; k < zeros; ++k) res[k] = std::complex<T>();
+			converged = n == zeros || aberth(c, n - zeros, res + zeros);
+			return n;
+		}
+
+		template <typename T>
+		T horner(T const* c, int n, T const& x) {
+			using std::fma;
+			T res = c[0];
+			for (int i = 1; i <= n; ++i) res = fma(res, x, c[i]);
+			return res;
+		}
+
+		// The Sturm sequence of p, with p0 = p, p1 = p' and p_k+1 = -(p_k-1 mod p_k), in storage
+		// of sturmStorage(n) values: member k gets n - k + 1 of them, its coefficients pushed to
+		// the end, and the last n + 1 are for the division. Every member is scaled to a largest
+		// coefficient of 1, which keeps the signs. The rounding error of each member is tracked
+		// along, as scaling up a small remainder scales up its error too, and remainders within
+		// a few times that error are 0. Returns the number of members.
+		template <typename T>
+		int sturm(T const* c, int n, T* storage) {
+			T* divided = storage + (n + 1) * (n + 2) / 2;
+			auto member = [storage, n](int k) { return storage + k * (n + 1) - k * (k - 1) / 2; };
+			auto normalize = [](T* p, int count) {
+				T scale = T();
+				for (int i = 0; i < count; ++i) scale = std::max(scale, std::abs(p[i]));
+				for (int i = 0; i < count; ++i) p[i] /= scale;
+				return scale;
+			};
+			T const eps = std::numeric_limits<T>::epsilon();
+			std::copy(c, c + n + 1, member(0));
+			normalize(member(0), n + 1);
+			for (int i = 0; i < n; ++i) member(1)[i] = member(0)[i] * T(n - i);
+			normalize(member(1), n);
+			T errorA = eps, errorB = eps;
+
+			int count = 2;
+			for (int k = 1; ; ++k) {
+				// the true degrees of the dividend a and the divisor b, in their slots
+				T const* a = member(k - 1);
+				int const slotA = n - k + 2;
+				int offsetA = 0;
+				while (a[offsetA] == T()) ++offsetA;
+				T const* b = member(k);
+				int const slotB = n - k + 1;
+				int offsetB = 0;
+				while (b[offsetB] == T()) ++offsetB;
+				int const degreeA = slotA - 1 - offsetA, degreeB = slotB - 1 - offsetB;
+				if (degreeB == 0) return count;
+
+				std::copy(a + offsetA, a + slotA, divided);
+				T largestQuotient = T();
+				for (int i = 0; i <= degreeA - degreeB; ++i) {
+					T const quotient = divided[i] / b[offsetB];
+					largestQuotient = std::max(largestQuotient, std::abs(quotient));
+					for (int j = 0; j <= degreeB; ++j) divided[i + j] -= quotient * b[offsetB + j];
+				}
+				T const error = errorA + largestQuotient * errorB + eps * (T(1) + largestQuotient);
+				T const tolerance = T(4) * error;
+				T* next = member(k + 1);
+				int const slotNext = n - k;
+				bool zero = true;
+				for (int i = 0; i < slotNext; ++i) {
+					// the remainder has degreeB coefficients, at the end of divided
+					int const from = degreeA + 1 - slotNext + i;
+					T const value = from > degreeA - degreeB ? -divided[from] : T();
+					next[i] = std::abs(value) <= tolerance ? T() : value;
+					zero = zero && next[i] == T();
+				}
+				// the last member is the gcd of p and p', a constant unless p has multiple roots
+				if (zero) return count;
+				errorA = errorB;
+				errorB = error / normalize(next, slotNext);
+				++count;
+			}
+		}
+
+		// sign changes of the sequence at x, zeros skipped
+		template <typename T>
+		int changes(T const* storage, int n, int members, T const& x) {
+			int res = 0;
+			T last = T();
+			for (int k = 0; k < members; ++k) {
+				T const value = horner(storage + k * (n + 1) - k * (k - 1) / 2, n - k, x);
+				if (value == T()) continue;
+				res += last != T() && (value < T()) != (last < T()) ? 1 : 0;
+				last = value;
+			}
+			return res;
+		}
+
+		// the sign change of p in [a, b], halved down to neighbouring floats
+		template <typename T>
+		T bisect(T const* c, int n, T a, T b) {
+			bool const negativeA = horner(c, n, a) < T();
+			for (;;) {
+				T const mid = a + (b - a) / T(2);
+				if (!(a < mid && mid < b)) return mid;
+				T const value = horner(c, n, mid);
+				if (value == T()) return mid;
+				if ((value < T()) == negativeA) a = mid;
+				else b = mid;
+			}
+		}
+
+		// Splits (a, b] until every piece holds one distinct root by the Sturm counts ca - cb,
+		// then finds it by bisection when p changes sign there, as it does at roots of odd
+		// multiplicity. Roots closer than neighbouring floats are reported at one point.
+		template <typename T>
+		void isolate(T const* c, int n, T const* storage, int members, T a, T b, int ca, int cb, T* res, int& found) {
+			int const count = std::min(ca - cb, n - found);
+			if (count <= 0) return;
+			if (count == 1) {
+				T const valueA = horner(c, n, a), valueB = horner(c, n, b);
+				if (valueB == T()) {
+					res[found++] = b;
+					return;
+				}
+				if (valueA != T() && (valueA < T()) != (valueB < T())) {
+					res[found++] = bisect(c, n, a, b);
+					return;
+				}
+			}
+			T const mid = a + (b - a) / T(2);
+			if (!(a < mid && mid < b)) {
+				for (int k = 0; k < count; ++k) res[found++] = mid;
+				return;
+			}
+			int const cm = changes(storage, n, members, mid);
+			isolate(c, n, storage, members, a, mid, ca, cm, res, found);
+			isolate(c, n, storage, members, mid, b, cm, cb, res, found);
+		}
+
+		// the distinct real roots in [start, end], ascending; storage as for sturm()
+		template <typename T>
+		int realRoots(T const* coefficients, int degree, T const& start, T const& end, T* res, T* storage) {
+			assert(degree >= 0 && start <= end);
+			int first = 0;
+			while (first < degree && coefficients[first] == T()) ++first;
+			T const* c = coefficients + first;
+			int const n = degree - first;
+			if (n == 0) return 0;
+			int found = 0;
+			if (horner(c, n, start) == T()) res[found++] = start;
+			if (start == end) return found;
+			int const members = sturm(c, n, storage);
+			isolate(c, n, storage, members, start, end, changes(storage, n, members, start), changes(storage, n, members, end), res, found);
+			return found;
+		}
+
+	};
+
+	// All complex roots of coefficients[0] x^degree + ... + coefficients[degree], with
+	// multiplicity and in no particular order, by Aberth-Ehrlich iteration. Leading zero
+	// coefficients lower the degree; the true degree is returned, the count of roots written.
+	// converged, when given, tells whether every root met the stopping test; roots of high
+	// multiplicity are found to about eps^(1 / multiplicity) only, as by any method.
+	template <typename T>
+	int roots(T const* coefficients, int degree, std::complex<T>* res, bool* converged = nullptr) {
+		bool done;
+		int const count = _RootsInternal::roots(coefficients, degree, res, done);
+		if (converged) *converged = done;
+		return count;
+	}
+
+	// up to N roots
+	template <int N, typename T>
+	int roots(PolynomicFunction<N, T> const& poly, std::complex<T>* res, bool* converged = nullptr) {
+		return roots(poly.coefficients(), N, res, converged);
+	}
+
+	// degree() roots
+	template <typename T, int InlineCapacity>
+	int roots(Polynomial<T, InlineCapacity> const& poly, std::complex<T>* res, bool* converged = nullptr) {
+		return roots(poly.coefficients(), poly.degree(), res, converged);
+	}
+
+	// roots of the numerator and of the denominator; factors common to both are not cancelled
+	template <typename T, int NUMERATOR, int DENOMINATOR>
+	int zeros(RationalFunction<T, NUMERATOR, DENOMINATOR> const& func, std::complex<T>* res, bool* converged = nullptr) {
+		return roots(func.numerator(), res, converged);
+	}
+
+	template <typename T, int NUMERATOR, int DENOMINATOR>
+	int poles(RationalFunction<T, NUMERATOR, DENOMINATOR> const& func, std::complex<T>* res, bool* converged = nullptr) {
+		return roots(func.denominator(), res, converged);
+	}
+
+	// The distinct real roots in [start, end], ascending, each once whatever its multiplicity.
+	// Sturm's sequence counts the roots of any piece of the interval, so pieces are halved until
+	// they hold one root, which bisection then finds to the last bit; no complex arithmetic and
+	// no root outside the interval is involved. The zero polynomial has no roots here.
+	template <typename T>
+	int realRoots(T const* coefficients, int degree, T const& start, T const& end, T* res) {
+		std::vector<T> storage(_RootsInternal::sturmStorage(degree));
+		return _RootsInternal::realRoots(coefficients, degree, start, end, res, storage.data());
+	}
+
+	// up to N roots, with no allocation
+	template <int N, typename T>
+	int realRoots(PolynomicFunction<N, T> const& poly, T const& start, T const& end, T* res) {
+		T storage[_RootsInternal::sturmStorage(N)];
+		return _RootsInternal::realRoots(poly.coefficients(), N, start, end, res, storage);
+	}
+
+	template <typename T, int InlineCapacity>
+	int realRoots(Polynomial<T, InlineCapacity> const& poly, T const& start, T const& end, T* res) {
+		return realRoots(poly.coefficients(), poly.degree(), start, end, res);
+	}
+
+	// The roots of count polynomials, e.g. thousands of quartics, spread over threads; N slots
+	// of res per polynomial, those beyond its true degree set to NaN. converged, when given,
+	// holds one flag per polynomial.
+	template <int N, typename T>
+	void roots(PolynomicFunction<N, T> const* polys, int count, std::complex<T>* res, bool* converged = nullptr) {
+		parallel::forRange(count, std::max(1, parallel::MinWorkPerThread / (16 * N * N)), [polys, res, converged](int begin, int end) {
+			T const nan = std::numeric_limits<T>::quiet_NaN();
+			for (int i = begin; i < end; ++i) {
+				bool done;
+				int const found = _RootsInternal::roots(polys[i].coefficients(), N, res + i * N, done);
+				std::fill(res + i * N + found, res + (i + 1) * N, std::complex<T>(nan, nan));
+				if (converged) converged[i] = done;
+			}
+		});
+	}
+
+	// realRoots of count polynomials on one interval; N slots of res per polynomial, found[i]
+	// of them used
+	template <int N, typename T>
+	void realRoots(PolynomicFunction<N, T> const* polys, int count, T const& start, T const& end, T* res, int* found) {
+		parallel::forRange(count, std::max(1, parallel::MinWorkPerThread / (64 * N)), [polys, start, end, res, found](int first, int last) {
+			T storage[_RootsInternal::sturmStorage(N)];
+			for (int i = first; i < last; ++i) {
+				found[i] = _RootsInternal::realRoots(polys[i].coefficients(), N, start, end, res + i * N, storage);
+			}
+		});
+	}
+
+}
+
+#endif // !_BICYCLE_ROOTS_H_
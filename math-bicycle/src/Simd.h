@@ -0,0 +1,212 @@
+#ifndef _BICYCLE_SIMD_H_
+#define _BICYCLE_SIMD_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <type_traits>
+
+// Alignment of matrix storage in bytes. 0 keeps natural alignment and tightly packed rows,
+// 32 (AVX) or 64 (AVX-512, cache line) pads every row so it starts on a vector boundary.
+#ifndef BM_MATRIX_ALIGNMENT
+#define BM_MATRIX_ALIGNMENT 0
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define BM_ASSUME_ALIGNED(PTR, ALIGNMENT) static_cast<decltype(PTR)>(__builtin_assume_aligned((PTR), (ALIGNMENT)))
+#else
+#define BM_ASSUME_ALIGNED(PTR, ALIGNMENT) (PTR)
+#endif
+
+#define BM_RESTRICT __restrict
+
+namespace bm {
+
+	// Properties of an element type. Compact storage types (half, FixedPoint) specialize it:
+	// they are numbers with 0 and 1, but arithmetic and sums run in the wider Compute type.
+	template <typename T>
+	struct ScalarTraits {
+
+		static constexpr bool isNumber = std::is_arithmetic<T>::value;
+
+		using Compute = T;
+
+	};
+
+	namespace simd {
+
+		static_assert(
+			BM_MATRIX_ALIGNMENT >= 0 && (BM_MATRIX_ALIGNMENT & (BM_MATRIX_ALIGNMENT - 1)) == 0,
+			"BM_MATRIX_ALIGNMENT should be 0 or a power of two."
+		);
+
+		// Memory layout of a row-major block of T: how many elements fit in one vector register
+		// and how far apart rows have to be so that each of them stays aligned.
+		template <typename T, int Alignment = BM_MATRIX_ALIGNMENT>
+		struct Layout {
+
+			static constexpr bool padded = Alignment > 0 && Alignment % sizeof(T) == 0;
+
+			static constexpr int lanes = padded ? static_cast<int>(Alignment / sizeof(T)) : 1;
+
+			static constexpr std::size_t alignment = padded && Alignment > alignof(T) ? Alignment : alignof(T);
+
+			static constexpr int stride(int len) {
+				return (len + lanes - 1) / lanes * lanes;
+			}
+
+		};
+
+		template <typename T>
+		bool isAligned(T const* ptr, std::size_t alignment) {
+			return reinterpret_cast<std::uintptr_t>(ptr) % alignment == 0;
+		}
+
+		// Allocator for heap storage of runtime sized types, keeps the first element on Alignment.
+		template <typename T, std::size_t Alignment = Layout<T>::alignment>
+		struct AlignedAllocator {
+
+			using value_type = T;
+
+			static constexpr std::size_t alignment = Alignment > alignof(T) ? Alignment : alignof(T);
+
+			template <typename U>
+			struct rebind { using other = AlignedAllocator<U, Alignment>; };
+
+			AlignedAllocator() = default;
+
+			template <typename U>
+			AlignedAllocator(AlignedAllocator<U, Alignment> const&) { }
+
+			T* allocate(std::size_t n) {
+				return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(alignment)));
+			}
+
+			void deallocate(T* ptr, std::size_t) {
+				::operator delete(ptr, std::align_val_t(alignment));
+			}
+
+			template <typename U>
+			bool operator==(AlignedAllocator<U, Alignment> const&) const { return true; }
+
+			template <typename U>
+			bool operator!=(AlignedAllocator<U, Alignment> const&) const { return false; }
+
+		};
+
+		// Elementwise kernels over contiguous blocks. Loops are branch free and unit stride with
+		// non-aliasing operands so the compiler turns them into packed loads and stores;
+		// Alignment tells it which boundary the pointers start on.
+
+		// x[i] = value
+		template <std::size_t Alignment = 1, typename T>
+		void fill(T* BM_RESTRICT x, T const value, int n) {
+			x = BM_ASSUME_ALIGNED(x, Alignment);
+			for (int i = 0; i < n; ++i) x[i] = value;
+		}
+
+		// x[i] = x[i] * s
+		template <std::size_t Alignment = 1, typename T>
+		void scal(T* BM_RESTRICT x, T const s, int n) {
+			x = BM_ASSUME_ALIGNED(x, Alignment);
+			for (int i = 0; i < n; ++i) x[i] = x[i] * s;
+		}
+
+		// x[i] = x[i] / s, one reciprocal and n multiplications for floating point types
+		template <std::size_t Alignment = 1, typename T>
+		void invScal(T* BM_RESTRICT x, T const s, int n) {
+			if constexpr (std::is_floating_point<T>::value) {
+				scal<Alignment>(x, T(1) / s, n);
+			}
+			else {
+				x = BM_ASSUME_ALIGNED(x, Alignment);
+				for (int i = 0; i < n; ++i) x[i] = x[i] / s;
+			}
+		}
+
+		// y[i] = y[i] + x[i]
+		template <std::size_t Alignment = 1, typename T>
+		void add(T* BM_RESTRICT y, T const* BM_RESTRICT x, int n) {
+			y = BM_ASSUME_ALIGNED(y, Alignment);
+			x = BM_ASSUME_ALIGNED(x, Alignment);
+			for (int i = 0; i < n; ++i) y[i] = y[i] + x[i];
+		}
+
+		// y[i] = y[i] + x[i] * s
+		template <std::size_t Alignment = 1, typename T>
+		void axpy(T* BM_RESTRICT y, T const* BM_RESTRICT x, T const s, int n) {
+			y = BM_ASSUME_ALIGNED(y, Alignment);
+			x = BM_ASSUME_ALIGNED(x, Alignment);
+			for (int i = 0; i < n; ++i) y[i] = y[i] + x[i] * s;
+		}
+
+		// y[i] = y[i] + x[i] / s, one reciprocal and n multiplications for floating point types
+		template <std::size_t Alignment = 1, typename T>
+		void invAxpy(T* BM_RESTRICT y, T const* BM_RESTRICT x, T const s, int n) {
+			if constexpr (std::is_floating_point<T>::value) {
+				axpy<Alignment>(y, x, T(1) / s, n);
+			}
+			else {
+				y = BM_ASSUME_ALIGNED(y, Alignment);
+				x = BM_ASSUME_ALIGNED(x, Alignment);
+				for (int i = 0; i < n; ++i) y[i] = y[i] + x[i] / s;
+			}
+		}
+
+		// y[i] = To(x[i]). Floating point values going to a narrow integer type (unsigned char, short)
+		// are clamped to its range first, so out of range colors saturate instead of wrapping.
+		template <typename To, typename From>
+		void convert(From const* BM_RESTRICT x, To* BM_RESTRICT y, int n) {
+			if constexpr (
+				std::is_floating_point<From>::value && std::is_integral<To>::value &&
+				std::numeric_limits<To>::digits <= std::numeric_limits<From>::digits
+			) {
+				From const lowest = From(std::numeric_limits<To>::lowest());
+				From const highest = From(std::numeric_limits<To>::max());
+				for (int i = 0; i < n; ++i) y[i] = static_cast<To>(std::min(std::max(x[i], lowest), highest));
+			}
+			else {
+				for (int i = 0; i < n; ++i) y[i] = static_cast<To>(x[i]);
+			}
+		}
+
+		// convert() for count objects of len values each, e.g. vectors whose reference members keep
+		// an array of them from being one buffer. from(i) and to(i) point to the values of object i,
+		// which are gathered into blocks so every block is converted by a single call. An object larger
+		// than a block is converted in place with one call of its own.
+		template <typename To, typename From, typename FromAt, typename ToAt>
+		void convertObjects(int count, int len, FromAt const& from, ToAt const& to) {
+			constexpr int ConvertBlock = 1024;
+			if (len > ConvertBlock) {
+				for (int i = 0; i < count; ++i) convert(from(i), to(i), len);
+				return;
+			}
+			From source[ConvertBlock];
+			To target[ConvertBlock];
+			int const perBlock = ConvertBlock / len;
+			for (int start = 0; start < count; start += perBlock) {
+				int const n = std::min(perBlock, count - start);
+				for (int i = 0; i < n; ++i) std::copy(from(start + i), from(start + i) + len, source + i * len);
+				convert(source, target, n * len);
+				for (int i = 0; i < n; ++i) std::copy(target + i * len, target + (i + 1) * len, to(start + i));
+			}
+		}
+
+		template <std::size_t Alignment = 1, typename T>
+		void swap(T* BM_RESTRICT x, T* BM_RESTRICT y, int n) {
+			x = BM_ASSUME_ALIGNED(x, Alignment);
+			y = BM_ASSUME_ALIGNED(y, Alignment);
+			for (int i = 0; i < n; ++i) {
+				T const temp = x[i];
+				x[i] = y[i];
+				y[i] = temp;
+			}
+		}
+
+	}
+
+}
+
+#endif // !_BICYCLE_SIMD_H_
@@ -0,0 +1,350 @@
+#ifndef _BICYCLE_SIMD_MATH_H_
+#define _BICYCLE_SIMD_MATH_H_
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+namespace bm {
+
+	namespace simd {
+
+		// values one math kernel call handles at once, small enough for the stack and L1
+		constexpr int MathBlock = 256;
+
+		namespace _SimdMathInternal {
+
+			template <typename T>
+			using UInt = std::conditional_t<sizeof(T) == 4, std::uint32_t, std::uint64_t>;
+
+			template <typename T>
+			UInt<T> toBits(T value) {
+				UInt<T> bits;
+				std::memcpy(&bits, &value, sizeof(bits));
+				return bits;
+			}
+
+			template <typename T>
+			T fromBits(UInt<T> bits) {
+				T value;
+				std::memcpy(&value, &bits, sizeof(value));
+				return value;
+			}
+
+			// condition ? a : b on masks, a ternary on floating point values may become a branch
+			template <typename T>
+			T select(bool condition, T a, T b) {
+				UInt<T> const mask = UInt<T>(0) - static_cast<UInt<T>>(condition);
+				return fromBits<T>((toBits(a) & mask) | (toBits(b) & ~mask));
+			}
+
+			// Adding 1.5 * 2^mantissa bits rounds to the nearest integer in the default rounding mode,
+			// without the library call nearbyint becomes below SSE4.1. The integer is then in the low bits.
+			template <typename T>
+			struct Round {
+
+				static constexpr T magic = T(1.5) * T(std::uint64_t(1) << (std::numeric_limits<T>::digits - 1));
+
+				T value;
+				UInt<T> integer;
+
+				explicit Round(T x) {
+					T const shifted = x + magic;
+					value = shifted - magic;
+					integer = toBits(shifted) - toBits(magic);
+				}
+
+			};
+
+			// 2^n for n in the range of normal exponents
+			template <typename T>
+			T pow2(UInt<T> n) {
+				constexpr int mantissaBits = std::numeric_limits<T>::digits - 1;
+				constexpr UInt<T> bias = std::numeric_limits<T>::max_exponent - 1;
+				return fromBits<T>((n + bias) << mantissaBits);
+			}
+
+			// Kernels after Cephes (S. L. Moshier): branch free on the range `covers` accepts, so loops
+			// over them vectorize; everything else goes to the std function.
+			template <typename T>
+			struct Exp;
+
+			template <>
+			struct Exp<float> {
+				static bool covers(float x) { return (x >= -87.0f) & (x <= 88.0f); }
+				static float reference(float x) { return std::exp(x); }
+				static float compute(float x) {
+					Round<float> const n(x * 1.44269504088896341f);
+					float const r = x - n.value * 0.693359375f + n.value * 2.12194440e-4f;
+					float const z = r * r;
+					float p = 1.9875691500e-4f;
+					p = p * r + 1.3981999507e-3f;
+					p = p * r + 8.3334519073e-3f;
+					p = p * r + 4.1665795894e-2f;
+					p = p * r + 1.6666665459e-1f;
+					p = p * r + 5.0000001201e-1f;
+					return (p * z + r + 1.0f) * pow2<float>(n.integer);
+				}
+			};
+
+			template <>
+			struct Exp<double> {
+				static bool covers(double x) { return (x >= -708.0) & (x <= 709.0); }
+				static double reference(double x) { return std::exp(x); }
+				static double compute(double x) {
+					Round<double> const n(x * 1.4426950408889634073599);
+					double const r = x - n.value * 6.93145751953125e-1 - n.value * 1.42860682030941723212e-6;
+					double const z = r * r;
+					double const p = r * ((1.26177193074810590878e-4 * z + 3.02994407707441961300e-2) * z + 9.99999999999999999910e-1);
+					double const q = ((3.00198505138664455042e-6 * z + 2.52448340349684104192e-3) * z + 2.27265548208155028766e-1) * z + 2.0;
+					return (1.0 + 2.0 * p / (q - p)) * pow2<double>(n.integer);
+				}
+			};
+
+			template <typename T>
+			struct Log;
+
+			template <>
+			struct Log<float> {
+				static bool covers(float x) { return (x >= std::numeric_limits<float>::min()) & (x <= std::numeric_limits<float>::max()); }
+				static float reference(float x) { return std::log(x); }
+				static float compute(float x) {
+					// x = m * 2^e with m in [sqrt(1/2), sqrt(2))
+					std::uint32_t const bits = toBits(x);
+					float const m = fromBits<float>((bits & 0x007FFFFFu) | 0x3F000000u);
+					bool const small = m < 0.707106781186547524f;
+					float const e = float(int(bits >> 23) - 126) - select(small, 1.0f, 0.0f);
+					float const f = m - 1.0f + select(small, m, 0.0f);
+					float const z = f * f;
+					float p = 7.0376836292e-2f;
+					p = p * f - 1.1514610310e-1f;
+					p = p * f + 1.1676998740e-1f;
+					p = p * f - 1.2420140846e-1f;
+					p = p * f + 1.4249322787e-1f;
+					p = p * f - 1.6668057665e-1f;
+					p = p * f + 2.0000714765e-1f;
+					p = p * f - 2.4999993993e-1f;
+					p = p * f + 3.3333331174e-1f;
+					float const y = f * z * p - e * 2.12194440e-4f - 0.5f * z;
+					return f + y + e * 0.693359375f;
+				}
+			};
+
+			template <>
+			struct Log<double> {
+				static bool covers(double x) { return (x >= std::numeric_limits<double>::min()) & (x <= std::numeric_limits<double>::max()); }
+				static double reference(double x) { return std::log(x); }
+				static double compute(double x) {
+					std::uint64_t const bits = toBits(x);
+					double const m = fromBits<double>((bits & 0x000FFFFFFFFFFFFFull) | 0x3FE0000000000000ull);
+					bool const small = m < 0.70710678118654752440;
+					double const e = double(int(bits >> 52) - 1022) - select(small, 1.0, 0.0);
+					double const f = m - 1.0 + select(small, m, 0.0);
+					double const z = f * f;
+					double p = 1.01875663804580931796e-4;
+					p = p * f + 4.97494994976747001425e-1;
+					p = p * f + 4.70579119878881725854e0;
+					p = p * f + 1.44989225341610930846e1;
+					p = p * f + 1.79368678507819816313e1;
+					p = p * f + 7.70838733755885391666e0;
+					double q = f + 1.12873587189167450590e1;
+					q = q * f + 4.52279145837532221105e1;
+					q = q * f + 8.29875266912776603211e1;
+					q = q * f + 7.11544750618563894466e1;
+					q = q * f + 2.31251620126765340583e1;
+					double const y = f * (z * p / q) - e * 2.121944400546905827679e-4 - 0.5 * z;
+					return f + y + e * 0.693359375;
+				}
+			};
+
+			// sin and cos of x = r + q * pi / 2, |r| <= pi / 4: both polynomials are evaluated,
+			// the quadrant picks one of them and the sign
+			template <typename T>
+			struct Quadrant;
+
+			template <>
+			struct Quadrant<float> {
+				static constexpr float limit = 8192.0f;
+				static void reduce(float x, float& sin, float& cos, std::uint32_t& quadrant) {
+					Round<float> const j(x * 0.636619772367581343f);
+					float const r = ((x - j.value * 1.5703125f) - j.value * 4.8375129699707031e-4f) - j.value * 7.5497899548918821e-8f;
+					float const z = r * r;
+					sin = r + r * z * ((-1.9515295891e-4f * z + 8.3321608736e-3f) * z - 1.6666654611e-1f);
+					cos = 1.0f - 0.5f * z + z * z * ((2.443315711809948e-5f * z - 1.388731625493765e-3f) * z + 4.166664568298827e-2f);
+					quadrant = j.integer;
+				}
+			};
+
+			template <>
+			struct Quadrant<double> {
+				static constexpr double limit = 1048576.0;
+				static void reduce(double x, double& sin, double& cos, std::uint64_t& quadrant) {
+					Round<double> const j(x * 0.63661977236758134308);
+					double const r = ((x - j.value * 1.57079625129699707031e0) - j.value * 7.54978941586159635335e-8) - j.value * 5.39030285815811905290e-15;
+					double const z = r * r;
+					double s = 1.58962301576546568060e-10;
+					s = s * z - 2.50507477628578072866e-8;
+					s = s * z + 2.75573136213857245213e-6;
+					s = s * z - 1.98412698295895385996e-4;
+					s = s * z + 8.33333333332211858878e-3;
+					s = s * z - 1.66666666666666307295e-1;
+					double c = -1.13585365213876817300e-11;
+					c = c * z + 2.08757008419747316778e-9;
+					c = c * z - 2.75573141792967388112e-7;
+					c = c * z + 2.48015872888517045348e-5;
+					c = c * z - 1.38888888888730564116e-3;
+					c = c * z + 4.16666666666665929218e-2;
+					sin = r + r * z * s;
+					cos = 1.0 - 0.5 * z + z * z * c;
+					quadrant = j.integer;
+				}
+			};
+
+			template <typename T>
+			struct Sin {
+				static bool covers(T x) { return (x >= -Quadrant<T>::limit) & (x <= Quadrant<T>::limit); }
+				static T reference(T x) { return std::sin(x); }
+				static T compute(T x) {
+					T s, c;
+					UInt<T> q;
+					Quadrant<T>::reduce(x, s, c, q);
+					T const res = select<T>(q & 1, c, s);
+					return fromBits<T>(toBits(res) ^ ((q & 2) << (sizeof(T) * 8 - 2)));
+				}
+			};
+
+			template <typename T>
+			struct Cos {
+				static bool covers(T x) { return (x >= -Quadrant<T>::limit) & (x <= Quadrant<T>::limit); }
+				static T reference(T x) { return std::cos(x); }
+				static T compute(T x) {
+					T s, c;
+					UInt<T> q;
+					Quadrant<T>::reduce(x, s, c, q);
+					T const res = select<T>(q & 1, s, c);
+					return fromBits<T>(toBits(res) ^ (((q + 1) & 2) << (sizeof(T) * 8 - 2)));
+				}
+			};
+
+			// y = Kernel(x) block by block: a vectorized pass, a vectorized check that every input was
+			// covered and a scalar pass over the rest only when one was not. x and y may be the same array.
+			template <template <typename> class Kernel, typename T>
+			void apply(T const* x, T* y, int n) {
+				for (int start = 0; start < n; start += MathBlock) {
+					int const len = std::min(MathBlock, n - start);
+					T const* in = x + start;
+					T res[MathBlock];
+					int covered = 1;
+					for (int i = 0; i < len; ++i) res[i] = Kernel<T>::compute(in[i]);
+					for (int i = 0; i < len; ++i) covered &= int(Kernel<T>::covers(in[i]));
+					if (!covered) {
+						for (int i = 0; i < len; ++i) {
+							if (!Kernel<T>::covers(in[i])) res[i] = Kernel<T>::reference(in[i]);
+						}
+					}
+					std::copy(res, res + len, y + start);
+				}
+			}
+
+			template <typename T>
+			constexpr bool hasKernel = std::is_same<T, float>::value || std::is_same<T, double>::value;
+
+		};
+
+		// y[i] = f(x[i]) for element types without a kernel; x and y may be the same array
+		template <typename T, typename F>
+		void map(T const* x, T* y, int n, F const& f) {
+			for (int i = 0; i < n; ++i) y[i] = f(x[i]);
+		}
+
+		// Elementwise math on arrays, x and y may be the same array. float and double go through
+		// vectorizable kernels accurate to a few ulp, other element types (Dual, half) through
+		// the scalar function found for them.
+		#define SIMD_MATH_KERNEL_FUNC(FUNC, KERNEL) \
+		template <typename T> \
+		void FUNC(T const* x, T* y, int n) { \
+			if constexpr (_SimdMathInternal::hasKernel<T>) _SimdMathInternal::apply<_SimdMathInternal::KERNEL>(x, y, n); \
+			else map(x, y, n, [](T const& v) -> T { using std::FUNC; return FUNC(v); }); \
+		}
+
+		SIMD_MATH_KERNEL_FUNC(exp, Exp)
+		SIMD_MATH_KERNEL_FUNC(log, Log)
+		SIMD_MATH_KERNEL_FUNC(sin, Sin)
+		SIMD_MATH_KERNEL_FUNC(cos, Cos)
+
+		#undef SIMD_MATH_KERNEL_FUNC
+
+		template <typename T>
+		void log10(T const* x, T* y, int n) {
+			if constexpr (_SimdMathInternal::hasKernel<T>) {
+				log(x, y, n);
+				for (int i = 0; i < n; ++i) y[i] *= T(0.43429448190325182765);
+			}
+			else {
+				map(x, y, n, [](T const& v) -> T { using std::log10; return log10(v); });
+			}
+		}
+
+		template <typename T>
+		void cosh(T const* x, T* y, int n) {
+			if constexpr (_SimdMathInternal::hasKernel<T>) {
+				exp(x, y, n);
+				for (int i = 0; i < n; ++i) y[i] = T(0.5) * (y[i] + T(1) / y[i]);
+			}
+			else {
+				map(x, y, n, [](T const& v) -> T { using std::cosh; return cosh(v); });
+			}
+		}
+
+		// (e^x - e^-x) / 2 cancels near 0, so sinh stays scalar
+		template <typename T>
+		void sinh(T const* x, T* y, int n) {
+			map(x, y, n, [](T const& v) -> T { using std::sinh; return sinh(v); });
+		}
+
+		template <typename T>
+		void sqrt(T const* x, T* y, int n) {
+			map(x, y, n, [](T const& v) -> T { using std::sqrt; return sqrt(v); });
+		}
+
+		// sin / cos from one reduction each, block by block so the cosines stay on the stack
+		template <typename T>
+		void tan(T const* x, T* y, int n) {
+			if constexpr (_SimdMathInternal::hasKernel<T>) {
+				for (int start = 0; start < n; start += MathBlock) {
+					int const len = std::min(MathBlock, n - start);
+					T c[MathBlock];
+					cos(x + start, c, len);
+					sin(x + start, y + start, len);
+					for (int i = 0; i < len; ++i) y[start + i] /= c[i];
+				}
+			}
+			else {
+				map(x, y, n, [](T const& v) -> T { using std::tan; return tan(v); });
+			}
+		}
+
+		// the exp form of tanh cancels near 0 as sinh does
+		template <typename T>
+		void tanh(T const* x, T* y, int n) {
+			map(x, y, n, [](T const& v) -> T { using std::tanh; return tanh(v); });
+		}
+
+		template <typename T>
+		void atan(T const* x, T* y, int n) {
+			map(x, y, n, [](T const& v) -> T { using std::atan; return atan(v); });
+		}
+
+		template <typename T>
+		void abs(T const* x, T* y, int n) {
+			map(x, y, n, [](T const& v) -> T { using std::abs; return abs(v); });
+		}
+
+	}
+
+}
+
+#endif // !_BICYCLE_SIMD_MATH_H_
@@ -0,0 +1,529 @@
+#ifndef _BICYCLE_SPATIAL_INDEX_H_
+#define _BICYCLE_SPATIAL_INDEX_H_
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include "Parallel.h"
+#include "Point.h"
+
+namespace bm {
+
+	namespace _SpatialInternal {
+
+		// a query touches a few leaves at most, fewer of them are not worth a thread
+		constexpr int MinQueriesPerThread = 1024;
+
+		// The k closest candidates seen so far, sorted by distance. k is small, so insertion into a
+		// sorted array beats a heap.
+		template <typename T>
+		struct KBest {
+
+			KBest(int k, int* indices, T* squaredDistances) : k(k), count(0), indices(indices), squaredDistances(squaredDistances) { }
+
+			T bound() const {
+				return count < k ? std::numeric_limits<T>::max() : squaredDistances[k - 1];
+			}
+
+			void add(int index, T squaredDistance) {
+				if (count == k && !(squaredDistance < squaredDistances[k - 1])) return;
+				// the last slot is free or dropped; the ones from the insertion point move into it
+				int const last = count < k ? count++ : k - 1;
+				int i = last;
+				while (i > 0 && squaredDistances[i - 1] > squaredDistance) --i;
+				std::copy_backward(indices + i, indices + last, indices + last + 1);
+				std::copy_backward(squaredDistances + i, squaredDistances + last, squaredDistances + last + 1);
+				indices[i] = index;
+				squaredDistances[i] = squaredDistance;
+			}
+
+			// marks the slots no point was found for
+			int finish() {
+				for (int i = count; i < k; ++i) {
+					indices[i] = -1;
+					squaredDistances[i] = std::numeric_limits<T>::max();
+				}
+				return count;
+			}
+
+			int k;
+			int count;
+			int* indices;
+			T* squaredDistances;
+		};
+
+		template <int Len, typename T>
+		T squaredDistance(T const* a, T const* b) {
+			T res = T();
+			for (int d = 0; d < Len; ++d) res = res + (a[d] - b[d]) * (a[d] - b[d]);
+			return res;
+		}
+
+		template <int Len, typename T>
+		bool inBox(T const* point, T const* min, T const* max) {
+			for (int d = 0; d < Len; ++d) {
+				if (point[d] < min[d] || point[d] > max[d]) return false;
+			}
+			return true;
+		}
+
+		template <int Len, typename T>
+		void copyCoords(Point<Len, T> const& point, T* coords) {
+			for (int d = 0; d < Len; ++d) coords[d] = point.at(d);
+		}
+
+		// Runs query(i, found) for every i in [0, count) on several threads and concatenates what the
+		// queries appended to found: indices of query i end up in [offsets[i], offsets[i + 1]).
+		template <typename Query>
+		void collect(int count, Query const& query, std::vector<int>& offsets, std::vector<int>& indices) {
+			offsets.assign(count + 1, 0);
+			indices.clear();
+			int const chunks = std::max(1, std::min(parallel::threadCount(), count / MinQueriesPerThread));
+			std::vector<std::vector<int>> chunkIndices(chunks);
+			std::vector<int> chunkBegins(chunks, count);
+			parallel::forChunks(chunks, count, [&query, &offsets, &chunkIndices, &chunkBegins](int chunk, int begin, int end) {
+				chunkBegins[chunk] = begin;
+				std::vector<int>& found = chunkIndices[chunk];
+				for (int i = begin; i < end; ++i) {
+					query(i, found);
+					offsets[i + 1] = static_cast<int>(found.size());
+				}
+			});
+			for (int chunk = 0; chunk < chunks; ++chunk) {
+				int const base = static_cast<int>(indices.size());
+				int const end = chunk + 1 < chunks ? chunkBegins[chunk + 1] : count;
+				for (int i = chunkBegins[chunk]; i < end; ++i) offsets[i + 1] += base;
+				indices.insert(indices.end(), chunkIndices[chunk].begin(), chunkIndices[chunk].end());
+			}
+		}
+
+		// Batched queries on top of the single point queries of Index, spread over threads.
+		template <typename Index, int Len, typename T>
+		struct SpatialIndexBase {
+
+			// k indices per query, row after row; slots past the number of indexed points hold -1
+			void knn(Point<Len, T> const* queries, int count, int k, int* indices, T* squaredDistances = nullptr) const {
+				assert(count >= 0 && k > 0);
+				parallel::forRange(count, MinQueriesPerThread, [this, queries, k, indices, squaredDistances](int begin, int end) {
+					std::vector<T> distancesBuffer(squaredDistances ? 0 : k);
+					for (int i = begin; i < end; ++i) {
+						T* const distances = squaredDistances ? squaredDistances + i * k : distancesBuffer.data();
+						index().knn(queries[i], k, indices + i * k, distances);
+					}
+				});
+			}
+
+			void radius(Point<Len, T> const* queries, int count, T radius, std::vector<int>& offsets, std::vector<int>& indices) const {
+				collect(count, [this, queries, radius](int i, std::vector<int>& found) { index().radius(queries[i], radius, found); }, offsets, indices);
+			}
+
+			void box(Point<Len, T> const* mins, Point<Len, T> const* maxs, int count, std::vector<int>& offsets, std::vector<int>& indices) const {
+				collect(count, [this, mins, maxs](int i, std::vector<int>& found) { index().box(mins[i], maxs[i], found); }, offsets, indices);
+			}
+
+		private:
+
+			Index const& index() const {
+				return static_cast<Index const&>(*this);
+			}
+		};
+
+	};
+
+	// Balanced k-d tree stored implicitly in one array: a node is a range of points, its median splits
+	// it along the axis of largest spread, ranges of up to leafSize points are scanned linearly.
+	// Coordinates are copied into a flat array in tree order, so a leaf is one contiguous block.
+	// Queries return indices into the array the tree was built from.
+	template <int Len, typename T>
+	class KdTree : public _SpatialInternal::SpatialIndexBase<KdTree<Len, T>, Len, T> {
+
+		using Base = _SpatialInternal::SpatialIndexBase<KdTree<Len, T>, Len, T>;
+
+	public:
+
+		using Base::knn;
+		using Base::radius;
+		using Base::box;
+
+		// subtrees of large ranges are built on separate threads
+		KdTree(Point<Len, T> const* points, int count, int leafSize = 8)
+			: m_count(count), m_leafSize(std::max(1, leafSize)), m_coords(count * Len), m_indices(count), m_splitDims(count, 0) {
+			assert(count >= 0);
+			std::vector<T> source(count * Len);
+			for (int i = 0; i < count; ++i) {
+				_SpatialInternal::copyCoords(points[i], source.data() + i * Len);
+				m_indices[i] = i;
+			}
+			build(source.data(), 0, count, parallel::threadCount());
+			for (int i = 0; i < count; ++i) {
+				std::copy(source.data() + m_indices[i] * Len, source.data() + (m_indices[i] + 1) * Len, m_coords.data() + i * Len);
+			}
+		}
+
+		int size() const {
+			return m_count;
+		}
+
+		// The k closest points sorted by distance, returns how many were found.
+		// Slots past the number of points hold index -1.
+		int knn(Point<Len, T> const& query, int k, int* indices, T* squaredDistances = nullptr) const {
+			assert(k > 0);
+			std::vector<T> distancesBuffer(squaredDistances ? 0 : k);
+			_SpatialInternal::KBest<T> best(k, indices, squaredDistances ? squaredDistances : distancesBuffer.data());
+			T q[Len];
+			_SpatialInternal::copyCoords(query, q);
+			searchKnn(q, 0, m_count, best);
+			return best.finish();
+		}
+
+		// -1 for an empty tree
+		int nearest(Point<Len, T> const& query) const {
+			int index;
+			T squaredDistance;
+			knn(query, 1, &index, &squaredDistance);
+			return index;
+		}
+
+		// appends the points not further than radius from query
+		void radius(Point<Len, T> const& query, T radius, std::vector<int>& indices) const {
+			T q[Len];
+			_SpatialInternal::copyCoords(query, q);
+			searchRadius(q, radius, radius * radius, 0, m_count, indices);
+		}
+
+		// appends the points inside the closed box [min, max]
+		void box(Point<Len, T> const& min, Point<Len, T> const& max, std::vector<int>& indices) const {
+			T lo[Len], hi[Len];
+			_SpatialInternal::copyCoords(min, lo);
+			_SpatialInternal::copyCoords(max, hi);
+			searchBox(lo, hi, 0, m_count, indices);
+		}
+
+	private:
+
+		T const* coords(int i) const {
+			return m_coords.data() + i * Len;
+		}
+
+		void build(T const* source, int begin, int end, int threads) {
+			if (end - begin <= m_leafSize) return;
+
+			T lo[Len], hi[Len];
+			std::copy(source + m_indices[begin] * Len, source + (m_indices[begin] + 1) * Len, lo);
+			std::copy(lo, lo + Len, hi);
+			for (int i = begin + 1; i < end; ++i) {
+				T const* point = source + m_indices[i] * Len;
+				for (int d = 0; d < Len; ++d) {
+					lo[d] = std::min(lo[d], point[d]);
+					hi[d] = std::max(hi[d], point[d]);
+				}
+			}
+			int dim = 0;
+			for (int d = 1; d < Len; ++d) {
+				if (hi[d] - lo[d] > hi[dim] - lo[dim]) dim = d;
+			}
+
+			int const mid = begin + (end - begin) / 2;
+			std::nth_element(m_indices.begin() + begin, m_indices.begin() + mid, m_indices.begin() + end, [source, dim](int a, int b) {
+				return source[a * Len + dim] < source[b * Len + dim];
+			});
+			m_splitDims[mid] = dim;
+
+			if (threads > 1 && end - begin >= parallel::MinWorkPerThread) {
+				parallel::forChunks(2, 2, [this, source, begin, mid, end, threads](int chunk, int, int) {
+					if (chunk == 0) build(source, begin, mid, threads / 2);
+					else build(source, mid + 1, end, threads - threads / 2);
+				});
+			}
+			else {
+				build(source, begin, mid, 1);
+				build(source, mid + 1, end, 1);
+			}
+		}
+
+		void searchKnn(T const* q, int begin, int end, _SpatialInternal::KBest<T>& best) const {
+			if (end - begin <= m_leafSize) {
+				for (int i = begin; i < end; ++i) best.add(m_indices[i], _SpatialInternal::squaredDistance<Len>(q, coords(i)));
+				return;
+			}
+			int const mid = begin + (end - begin) / 2;
+			int const dim = m_splitDims[mid];
+			T const diff = q[dim] - coords(mid)[dim];
+			best.add(m_indices[mid], _SpatialInternal::squaredDistance<Len>(q, coords(mid)));
+			if (diff < T()) {
+				searchKnn(q, begin, mid, best);
+				if (diff * diff < best.bound()) searchKnn(q, mid + 1, end, best);
+			}
+			else {
+				searchKnn(q, mid + 1, end, best);
+				if (diff * diff < best.bound()) searchKnn(q, begin, mid, best);
+			}
+		}
+
+		void searchRadius(T const* q, T radius, T squaredRadius, int begin, int end, std::vector<int>& indices) const {
+			if (end - begin <= m_leafSize) {
+				for (int i = begin; i < end; ++i) {
+					if (_SpatialInternal::squaredDistance<Len>(q, coords(i)) <= squaredRadius) indices.push_back(m_indices[i]);
+				}
+				return;
+			}
+			int const mid = begin + (end - begin) / 2;
+			int const dim = m_splitDims[mid];
+			T const split = coords(mid)[dim];
+			if (q[dim] - radius <= split) searchRadius(q, radius, squaredRadius, begin, mid, indices);
+			if (_SpatialInternal::squaredDistance<Len>(q, coords(mid)) <= squaredRadius) indices.push_back(m_indices[mid]);
+			if (q[dim] + radius >= split) searchRadius(q, radius, squaredRadius, mid + 1, end, indices);
+		}
+
+		void searchBox(T const* lo, T const* hi, int begin, int end, std::vector<int>& indices) const {
+			if (end - begin <= m_leafSize) {
+				for (int i = begin; i < end; ++i) {
+					if (_SpatialInternal::inBox<Len>(coords(i), lo, hi)) indices.push_back(m_indices[i]);
+				}
+				return;
+			}
+			int const mid = begin + (end - begin) / 2;
+			int const dim = m_splitDims[mid];
+			T const split = coords(mid)[dim];
+			if (lo[dim] <= split) searchBox(lo, hi, begin, mid, indices);
+			if (_SpatialInternal::inBox<Len>(coords(mid), lo, hi)) indices.push_back(m_indices[mid]);
+			if (hi[dim] >= split) searchBox(lo, hi, mid + 1, end, indices);
+		}
+
+		int m_count;
+		int m_leafSize;
+		std::vector<T> m_coords;
+		std::vector<int> m_indices;
+		std::vector<int> m_splitDims;
+	};
+
+	// Points bucketed by the cubic cell of side cellSize they fall into; cells are hashed into a table
+	// about as large as the point count, so only occupied space costs memory. Best when queries come
+	// from the same region as the points and radii are around cellSize; the k-d tree adapts to any
+	// distribution. Queries return indices into the array the grid was built from.
+	template <int Len, typename T>
+	class UniformGrid : public _SpatialInternal::SpatialIndexBase<UniformGrid<Len, T>, Len, T> {
+
+		static_assert(std::is_floating_point<T>::value, "UniformGrid needs floating point coordinates.");
+
+		using Base = _SpatialInternal::SpatialIndexBase<UniformGrid<Len, T>, Len, T>;
+
+	public:
+
+		using Base::knn;
+		using Base::radius;
+		using Base::box;
+
+		UniformGrid(Point<Len, T> const* points, int count, T cellSize)
+			: m_count(count), m_cellSize(cellSize), m_invCellSize(T(1) / cellSize), m_coords(count * Len), m_indices(count) {
+			assert(count >= 0 && cellSize > T());
+			int tableSize = 1;
+			while (tableSize < count) tableSize *= 2;
+			m_mask = static_cast<std::uint32_t>(tableSize - 1);
+
+			std::vector<T> source(count * Len);
+			std::vector<std::uint32_t> buckets(count);
+			std::fill(m_minCell, m_minCell + Len, std::numeric_limits<int>::max());
+			std::fill(m_maxCell, m_maxCell + Len, std::numeric_limits<int>::min());
+			for (int i = 0; i < count; ++i) {
+				T* const point = source.data() + i * Len;
+				_SpatialInternal::copyCoords(points[i], point);
+				int c[Len];
+				cellOf(point, c);
+				for (int d = 0; d < Len; ++d) {
+					m_minCell[d] = std::min(m_minCell[d], c[d]);
+					m_maxCell[d] = std::max(m_maxCell[d], c[d]);
+				}
+				buckets[i] = bucketOf(c);
+			}
+
+			// counting sort by bucket
+			m_bucketStarts.assign(tableSize + 1, 0);
+			for (int i = 0; i < count; ++i) ++m_bucketStarts[buckets[i] + 1];
+			for (int b = 0; b < tableSize; ++b) m_bucketStarts[b + 1] += m_bucketStarts[b];
+			std::vector<int> next(m_bucketStarts.begin(), m_bucketStarts.end() - 1);
+			for (int i = 0; i < count; ++i) {
+				int const slot = next[buckets[i]]++;
+				m_indices[slot] = i;
+				std::copy(source.data() + i * Len, source.data() + (i + 1) * Len, m_coords.data() + slot * Len);
+			}
+		}
+
+		int size() const {
+			return m_count;
+		}
+
+		T cellSize() const {
+			return m_cellSize;
+		}
+
+		// Same contract as KdTree::knn. Searches rings of cells around the query cell until no unvisited
+		// cell can hold a closer point.
+		int knn(Point<Len, T> const& query, int k, int* indices, T* squaredDistances = nullptr) const {
+			assert(k > 0);
+			std::vector<T> distancesBuffer(squaredDistances ? 0 : k);
+			_SpatialInternal::KBest<T> best(k, indices, squaredDistances ? squaredDistances : distancesBuffer.data());
+			if (m_count == 0) return best.finish();
+
+			T q[Len];
+			_SpatialInternal::copyCoords(query, q);
+			int center[Len];
+			cellOf(q, center);
+			// rings closer than the occupied cells are empty
+			int ring = 0, lastRing = 0;
+			for (int d = 0; d < Len; ++d) {
+				ring = std::max(ring, std::max(m_minCell[d] - center[d], center[d] - m_maxCell[d]));
+				lastRing = std::max(lastRing, std::max(center[d] - m_minCell[d], m_maxCell[d] - center[d]));
+			}
+			for (; ring <= lastRing; ++ring) {
+				forEachRingCell(center, ring, [this, q, &best](int const* c) {
+					scanCell(c, [this, q, &best](int slot) {
+						best.add(m_indices[slot], _SpatialInternal::squaredDistance<Len>(q, coords(slot)));
+					});
+				});
+				// any point outside the rings seen so far is at least ring cells away
+				T const reach = ring * m_cellSize;
+				if (best.count == k && best.bound() <= reach * reach) break;
+			}
+			return best.finish();
+		}
+
+		int nearest(Point<Len, T> const& query) const {
+			int index;
+			T squaredDistance;
+			knn(query, 1, &index, &squaredDistance);
+			return index;
+		}
+
+		void radius(Point<Len, T> const& query, T radius, std::vector<int>& indices) const {
+			T q[Len], lo[Len], hi[Len];
+			_SpatialInternal::copyCoords(query, q);
+			for (int d = 0; d < Len; ++d) {
+				lo[d] = q[d] - radius;
+				hi[d] = q[d] + radius;
+			}
+			T const squaredRadius = radius * radius;
+			scanBox(lo, hi, [this, q, squaredRadius, &indices](int slot) {
+				if (_SpatialInternal::squaredDistance<Len>(q, coords(slot)) <= squaredRadius) indices.push_back(m_indices[slot]);
+			});
+		}
+
+		void box(Point<Len, T> const& min, Point<Len, T> const& max, std::vector<int>& indices) const {
+			T lo[Len], hi[Len];
+			_SpatialInternal::copyCoords(min, lo);
+			_SpatialInternal::copyCoords(max, hi);
+			scanBox(lo, hi, [this, &lo, &hi, &indices](int slot) {
+				if (_SpatialInternal::inBox<Len>(coords(slot), lo, hi)) indices.push_back(m_indices[slot]);
+			});
+		}
+
+	private:
+
+		T const* coords(int slot) const {
+			return m_coords.data() + slot * Len;
+		}
+
+		void cellOf(T const* point, int* c) const {
+			for (int d = 0; d < Len; ++d) c[d] = static_cast<int>(std::floor(point[d] * m_invCellSize));
+		}
+
+		std::uint32_t bucketOf(int const* c) const {
+			std::uint32_t hash = 2166136261u;
+			for (int d = 0; d < Len; ++d) hash = (hash ^ static_cast<std::uint32_t>(c[d])) * 16777619u;
+			return (hash ^ (hash >> 15)) & m_mask;
+		}
+
+		// calls visit(c) for every cell c in [lo, hi]
+		template <typename Visit>
+		static void forEachCell(int const* lo, int const* hi, Visit const& visit) {
+			for (int d = 0; d < Len; ++d) {
+				if (lo[d] > hi[d]) return;
+			}
+			int c[Len];
+			std::copy(lo, lo + Len, c);
+			while (true) {
+				visit(static_cast<int const*>(c));
+				int d = 0;
+				for (; d < Len && c[d] == hi[d]; ++d) c[d] = lo[d];
+				if (d == Len) return;
+				++c[d];
+			}
+		}
+
+		// Calls visit(c) once for every cell c of the occupied range at Chebyshev distance ring from
+		// center: for each axis a the two faces c[a] = center[a] -+ ring, with the axes before a kept
+		// strictly inside the ring, so edges and corners are not visited twice.
+		template <typename Visit>
+		void forEachRingCell(int const* center, int ring, Visit const& visit) const {
+			int lo[Len], hi[Len];
+			for (int a = 0; a < Len; ++a) {
+				for (int d = 0; d < Len; ++d) {
+					int const inset = d < a ? 1 : 0;
+					lo[d] = std::max(center[d] - ring + inset, m_minCell[d]);
+					hi[d] = std::min(center[d] + ring - inset, m_maxCell[d]);
+				}
+				// the ring of 0 is the center cell alone, its two faces are the same
+				for (int side = -1; side <= 1; side += ring == 0 ? 3 : 2) {
+					int const face = center[a] + side * ring;
+					if (face < m_minCell[a] || face > m_maxCell[a]) continue;
+					lo[a] = face;
+					hi[a] = face;
+					forEachCell(lo, hi, visit);
+				}
+				if (ring == 0) return;
+			}
+		}
+
+		// calls visit(slot) for the points of cell c; other cells sharing its bucket are skipped
+		template <typename Visit>
+		void scanCell(int const* c, Visit const& visit) const {
+			std::uint32_t const bucket = bucketOf(c);
+			for (int slot = m_bucketStarts[bucket]; slot < m_bucketStarts[bucket + 1]; ++slot) {
+				int pointCell[Len];
+				cellOf(coords(slot), pointCell);
+				if (std::equal(pointCell, pointCell + Len, c)) visit(slot);
+			}
+		}
+
+		template <typename Visit>
+		void scanBox(T const* lo, T const* hi, Visit const& visit) const {
+			if (m_count == 0) return;
+			int loCell[Len], hiCell[Len];
+			cellOf(lo, loCell);
+			cellOf(hi, hiCell);
+			for (int d = 0; d < Len; ++d) {
+				loCell[d] = std::max(loCell[d], m_minCell[d]);
+				hiCell[d] = std::min(hiCell[d], m_maxCell[d]);
+			}
+			forEachCell(loCell, hiCell, [this, &visit](int const* c) { scanCell(c, visit); });
+		}
+
+		int m_count;
+		T m_cellSize;
+		T m_invCellSize;
+		std::uint32_t m_mask;
+		int m_minCell[Len];
+		int m_maxCell[Len];
+		std::vector<int> m_bucketStarts;
+		std::vector<T> m_coords;
+		std::vector<int> m_indices;
+	};
+
+	using KdTree2f = KdTree<2, float>;
+	using KdTree3f = KdTree<3, float>;
+	using KdTree2d = KdTree<2, double>;
+	using KdTree3d = KdTree<3, double>;
+
+	using UniformGrid2f = UniformGrid<2, float>;
+	using UniformGrid3f = UniformGrid<3, float>;
+	using UniformGrid2d = UniformGrid<2, double>;
+	using UniformGrid3d = UniformGrid<3, double>;
+
+}
+
+#endif // !_BICYCLE_SPATIAL_INDEX_H_
@@ -0,0 +1,209 @@
+#ifndef _BICYCLE_TABULATED_H_
+#define _BICYCLE_TABULATED_H_
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <vector>
+
+#include "Chebyshev.h"
+#include "Function.h"
+
+namespace bm {
+
+	enum class Interpolation {
+		// piecewise linear on a uniform grid, error ~ h^2
+		Linear,
+		// piecewise cubic through the four nearest nodes of a uniform grid, error ~ h^4
+		Cubic,
+		// one polynomial through Chebyshev points, see Chebyshev.h; error falls geometrically for smooth functions
+		Chebyshev
+	};
+
+	namespace _TabulatedInternal {
+
+		// intervals of the first grid, and the default limit of refinement
+		constexpr int MinIntervals = 16;
+		constexpr int MaxIntervals = 1 << 16;
+
+	};
+
+	// Func tabulated on [start, end] once, to answer later calls by interpolation. The grid
+	// starts with 16 intervals and is halved until the interpolant differs from func by at
+	// most tolerance at the midpoints of all intervals (the nodes the next grid would add), or
+	// until maxIntervals; error() is the largest such difference, so accurate() tells whether
+	// the tolerance was met. The check is a sampling, not a bound: features narrower than an
+	// interval can hide from it. Outside [start, end] the end pieces are extrapolated.
+	template <typename Func>
+	class Tabulated {
+
+		using ValT = _FunctionInternal::ValueOf<Func>;
+
+	public:
+
+		Tabulated(
+			Func const& func, ValT const& start, ValT const& end, ValT const& tolerance,
+			Interpolation interpolation = Interpolation::Cubic, int maxIntervals = _TabulatedInternal::MaxIntervals
+		) : m_func(func), m_start(start), m_end(end), m_tolerance(tolerance), m_interpolation(interpolation), m_chebyshev({ ValT() }, start, end) {
+			assert(start < end);
+			int intervals = _TabulatedInternal::MinIntervals;
+			m_nodes.resize(intervals + 1);
+			m_values.resize(intervals + 1);
+			for (int k = 0; k <= intervals; ++k) m_nodes[k] = node(2 * k, 2 * intervals);
+			_FunctionInternal::sample(m_func, m_nodes.data(), m_values.data(), intervals + 1);
+			updateChebyshev();
+
+			std::vector<ValT> checks, exact, interpolated;
+			for (;;) {
+				checks.resize(intervals);
+				exact.resize(intervals);
+				interpolated.resize(intervals);
+				for (int k = 0; k < intervals; ++k) checks[k] = node(2 * k + 1, 2 * intervals);
+				_FunctionInternal::sample(m_func, checks.data(), exact.data(), intervals);
+				evaluate(checks.data(), interpolated.data(), intervals);
+				m_error = ValT();
+				for (int k = 0; k < intervals; ++k) {
+					using std::abs;
+					ValT const difference = abs(exact[k] - interpolated[k]);
+					// a NaN counts as missing the tolerance
+					m_error = difference > m_error || difference != difference ? difference : m_error;
+				}
+				if (m_error <= m_tolerance || 2 * intervals > maxIntervals) break;
+
+				// the checked points are the new nodes, in between the old ones for either grid
+				std::vector<ValT> nodes(2 * intervals + 1), values(2 * intervals + 1);
+				for (int k = 0; k <= intervals; ++k) {
+					nodes[2 * k] = m_nodes[k];
+					values[2 * k] = m_values[k];
+				}
+				for (int k = 0; k < intervals; ++k) {
+					nodes[2 * k + 1] = checks[k];
+					values[2 * k + 1] = exact[k];
+				}
+				m_nodes.swap(nodes);
+				m_values.swap(values);
+				intervals *= 2;
+				updateChebyshev();
+			}
+		}
+
+		ValT operator()(ValT const& arg) const {
+			ValT res = ValT();
+			evaluate(&arg, &res, 1);
+			return res;
+		}
+
+		// res[i] = (*this)(args[i]); args and res may be the same array
+		void evaluate(ValT const* args, ValT* res, int count) const {
+			switch (m_interpolation) {
+			case Interpolation::Linear: evaluateLinear(args, res, count); break;
+			case Interpolation::Cubic: evaluateCubic(args, res, count); break;
+			case Interpolation::Chebyshev: evaluateChebyshev(args, res, count); break;
+			}
+		}
+
+		// largest difference from func found by the last check
+		ValT error() const {
+			return m_error;
+		}
+
+		bool accurate() const {
+			return m_error <= m_tolerance;
+		}
+
+		// number of nodes, i.e. of func calls kept
+		int size() const {
+			return static_cast<int>(m_nodes.size());
+		}
+
+		ValT start() const {
+			return m_start;
+		}
+
+		ValT end() const {
+			return m_end;
+		}
+
+		Func const& function() const {
+			return m_func;
+		}
+
+	private:
+
+		// node k of a grid of n intervals; Chebyshev points run from end to start
+		ValT node(int k, int n) const {
+			if (m_interpolation == Interpolation::Chebyshev) return _ChebyshevInternal::point(k, n, m_start, m_end);
+			return k == n ? m_end : m_start + (m_end - m_start) * ValT(k) / ValT(n);
+		}
+
+		// the grid coordinate of x, the index of the first node used and the offset from it
+		void locate(ValT const& x, int first, int last, int& index, ValT& offset) const {
+			int const intervals = size() - 1;
+			ValT const u = (x - m_start) * (ValT(intervals) / (m_end - m_start));
+			using std::floor;
+			// clamped as floats, so far away and NaN arguments cannot overflow the int; std::min
+			// takes the bound for NaN
+			ValT const cell = std::max(ValT(first), std::min(ValT(intervals - last), floor(u)));
+			index = static_cast<int>(cell) - first;
+			offset = u - ValT(index);
+		}
+
+		void evaluateLinear(ValT const* args, ValT* res, int count) const {
+			ValT const* values = m_values.data();
+			for (int i = 0; i < count; ++i) {
+				int index;
+				ValT t;
+				locate(args[i], 0, 1, index, t);
+				res[i] = values[index] + t * (values[index + 1] - values[index]);
+			}
+		}
+
+		// Lagrange weights of nodes index .. index + 3, with t in [1, 2] inside the domain
+		void evaluateCubic(ValT const* args, ValT* res, int count) const {
+			ValT const* values = m_values.data();
+			for (int i = 0; i < count; ++i) {
+				int index;
+				ValT t;
+				locate(args[i], 1, 2, index, t);
+				ValT const t1 = t - ValT(1), t2 = t - ValT(2), t3 = t - ValT(3);
+				ValT const sixth = ValT(1) / ValT(6), half = ValT(1) / ValT(2);
+				ValT const w0 = -t1 * t2 * t3 * sixth, w1 = t * t2 * t3 * half;
+				ValT const w2 = -t * t1 * t3 * half, w3 = t * t1 * t2 * sixth;
+				res[i] = w0 * values[index] + w1 * values[index + 1] + w2 * values[index + 2] + w3 * values[index + 3];
+			}
+		}
+
+		void evaluateChebyshev(ValT const* args, ValT* res, int count) const {
+			m_chebyshev.evaluate(args, res, count);
+		}
+
+		// the expansion through the current nodes, which run from end to start as Chebyshev points do
+		void updateChebyshev() {
+			if (m_interpolation == Interpolation::Chebyshev) {
+				m_chebyshev = Chebyshev<ValT>::interpolant(m_values.data(), size() - 1, m_start, m_end);
+			}
+		}
+
+		Func m_func;
+		ValT m_start;
+		ValT m_end;
+		ValT m_tolerance;
+		ValT m_error;
+		Interpolation m_interpolation;
+		std::vector<ValT> m_nodes;
+		std::vector<ValT> m_values;
+		Chebyshev<ValT> m_chebyshev;
+
+	};
+
+	template <typename Func, typename T>
+	Tabulated<Func> tabulate(
+		Func const& func, T const& start, T const& end, T const& tolerance,
+		Interpolation interpolation = Interpolation::Cubic, int maxIntervals = _TabulatedInternal::MaxIntervals
+	) {
+		return Tabulated<Func>(func, start, end, tolerance, interpolation, maxIntervals);
+	}
+
+}
+
+#endif // !_BICYCLE_TABULATED_H_
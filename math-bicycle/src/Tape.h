@@ -0,0 +1,451 @@
+#ifndef _BICYCLE_TAPE_H_
+#define _BICYCLE_TAPE_H_
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+#include "Function.h"
+#include "PolynomicFunction.h"
+
+namespace bm {
+
+	namespace _TapeInternal {
+
+		enum class Op { Argument, Constant, Add, Subtract, Multiply, Divide, Negate, Power, Unary, Polynomial };
+
+		// an elementary function of Function.h, reached through its tag at runtime
+		template <typename T>
+		struct UnaryFunc {
+			char const* name;
+			T (*apply)(T const&);
+			void (*batch)(T const*, T*, int);
+		};
+
+		template <typename Func, typename T>
+		UnaryFunc<T> const* unaryFunc() {
+			static UnaryFunc<T> const func = { Func::name, &Func::template apply<T>, &Func::template batch<T> };
+			return &func;
+		}
+
+		// One operation of a tape. Operands are the indices of earlier instructions, -1 when unused.
+		template <typename T>
+		struct Instruction {
+			Op op;
+			int left;
+			int right;
+			// the exponent of Power, the degree of Polynomial
+			int power;
+			// index into the constant pool: the value of Constant, the leading coefficient of Polynomial
+			int constant;
+			UnaryFunc<T> const* func;
+		};
+
+		// y = x^power by squaring over whole arrays; x and y may be the same array
+		template <typename T>
+		void power(T const* x, T* y, int n, int power) {
+			T base[EvaluationBlock];
+			std::copy(x, x + n, base);
+			std::fill(y, y + n, T(1));
+			for (int p = power < 0 ? -power : power; p > 0; p >>= 1) {
+				if (p & 1) for (int i = 0; i < n; ++i) y[i] *= base[i];
+				if (p > 1) for (int i = 0; i < n; ++i) base[i] *= base[i];
+			}
+			if (power < 0) for (int i = 0; i < n; ++i) y[i] = T(1) / y[i];
+		}
+
+		// the shortest decimal text that reads back to the same value
+		template <typename T>
+		std::string numberToString(T const& value) {
+			char buffer[32];
+			for (int digits = 1; ; ++digits) {
+				std::snprintf(buffer, sizeof(buffer), "%.*g", digits, static_cast<double>(value));
+				if (digits >= 17 || T(std::strtod(buffer, nullptr)) == value) return buffer;
+			}
+		}
+
+		// binding strength of the text of an instruction, for the parentheses of toString
+		enum Precedence { Sum = 1, Product, Sign, Exponent, Atom };
+
+		inline std::string wrap(std::string const& text, int precedence, int least) {
+			return precedence < least ? '(' + text + ')' : text;
+		}
+
+	};
+
+	template <typename T>
+	class TapeBuilder;
+
+	// An expression as a flat list of instructions over registers of EvaluationBlock values.
+	// Every distinct subexpression is one instruction, so it is evaluated once per argument
+	// however often it appears in the expression; registers are reused once their value is dead.
+	template <typename T>
+	class Tape {
+
+		friend class TapeBuilder<T>;
+
+		using Instruction = _TapeInternal::Instruction<T>;
+		using Op = _TapeInternal::Op;
+
+	public:
+
+		// the argument itself
+		Tape() : m_code{ { Op::Argument, -1, -1, 0, -1, nullptr } }, m_register{ -1 }, m_result(0), m_registers(0) { }
+
+		// one argument goes through evaluate(), batches are much cheaper per value
+		T operator()(T const& arg) const {
+			T res;
+			evaluate(&arg, &res, 1);
+			return res;
+		}
+
+		// res[i] = (*this)(args[i]); args and res may be the same array
+		void evaluate(T const* args, T* res, int count) const {
+			int const stride = std::min(count, EvaluationBlock);
+			if (stride <= 0) return;
+			std::vector<T> registers(static_cast<std::size_t>(m_registers) * stride);
+			// constants keep their registers for the whole call
+			for (int i = 0, n = size(); i < n; ++i) {
+				if (m_code[i].op == Op::Constant) {
+					std::fill_n(registers.data() + m_register[i] * stride, stride, m_constants[m_code[i].constant]);
+				}
+			}
+
+			for (int start = 0; start < count; start += stride) {
+				int const len = std::min(stride, count - start);
+				auto const in = [&](int value) -> T const* {
+					return m_register[value] < 0 ? args + start : registers.data() + m_register[value] * stride;
+				};
+				for (int i = 0, n = size(); i < n; ++i) {
+					Instruction const& ins = m_code[i];
+					if (ins.op == Op::Argument || ins.op == Op::Constant) continue;
+					T* const out = registers.data() + m_register[i] * stride;
+					switch (ins.op) {
+					case Op::Add: {
+						T const* left = in(ins.left); T const* right = in(ins.right);
+						for (int j = 0; j < len; ++j) out[j] = left[j] + right[j];
+						break;
+					}
+					case Op::Subtract: {
+						T const* left = in(ins.left); T const* right = in(ins.right);
+						for (int j = 0; j < len; ++j) out[j] = left[j] - right[j];
+						break;
+					}
+					case Op::Multiply: {
+						T const* left = in(ins.left); T const* right = in(ins.right);
+						for (int j = 0; j < len; ++j) out[j] = left[j] * right[j];
+						break;
+					}
+					case Op::Divide: {
+						T const* left = in(ins.left); T const* right = in(ins.right);
+						for (int j = 0; j < len; ++j) out[j] = left[j] / right[j];
+						break;
+					}
+					case Op::Negate: {
+						T const* left = in(ins.left);
+						for (int j = 0; j < len; ++j) out[j] = -left[j];
+						break;
+					}
+					case Op::Power:
+						_TapeInternal::power(in(ins.left), out, len, ins.power);
+						break;
+					case Op::Unary:
+						ins.func->batch(in(ins.left), out, len);
+						break;
+					case Op::Polynomial:
+						// the same roundings as PolynomicFunction::evaluate
+						_PolynomicFunctionInternal::hornerBlock(m_constants.data() + ins.constant, ins.power, in(ins.left), out, len);
+						break;
+					default:
+						break;
+					}
+				}
+				T const* result = in(m_result);
+				std::copy(result, result + len, res + start);
+			}
+		}
+
+		// instructions, the argument and the constants included
+		int size() const {
+			return static_cast<int>(m_code.size());
+		}
+
+		// instructions that compute something for every argument
+		int operations() const {
+			return static_cast<int>(std::count_if(m_code.begin(), m_code.end(), [](Instruction const& ins) {
+				return ins.op != Op::Argument && ins.op != Op::Constant;
+			}));
+		}
+
+		// Infix text of the expression in the argument x. parse() (TapeParser.h) reads it back into a tape
+		// of the same expression: its values agree up to rounding and its text up to the order of the
+		// operands of + and *. Polynomials are written in Horner form and come back as multiplications
+		// and additions.
+		std::string toString() const {
+			using namespace _TapeInternal;
+			int const n = size();
+			std::vector<std::string> text(n);
+			std::vector<int> precedence(n, Atom);
+			auto const binary = [&](int i, char op, int opPrecedence) {
+				Instruction const& ins = m_code[i];
+				text[i] = wrap(text[ins.left], precedence[ins.left], opPrecedence) + op
+					+ wrap(text[ins.right], precedence[ins.right], opPrecedence + 1);
+				precedence[i] = opPrecedence;
+			};
+			for (int i = 0; i < n; ++i) {
+				Instruction const& ins = m_code[i];
+				switch (ins.op) {
+				case Op::Argument:
+					text[i] = "x";
+					break;
+				case Op::Constant:
+					text[i] = numberToString(m_constants[ins.constant]);
+					precedence[i] = text[i][0] == '-' ? Sign : Atom;
+					break;
+				case Op::Add: binary(i, '+', Sum); break;
+				case Op::Subtract: binary(i, '-', Sum); break;
+				case Op::Multiply: binary(i, '*', Product); break;
+				case Op::Divide: binary(i, '/', Product); break;
+				case Op::Negate:
+					text[i] = '-' + wrap(text[ins.left], precedence[ins.left], Sign);
+					precedence[i] = Sign;
+					break;
+				case Op::Power:
+					text[i] = wrap(text[ins.left], precedence[ins.left], Atom) + '^' + std::to_string(ins.power);
+					precedence[i] = Exponent;
+					break;
+				case Op::Unary:
+					text[i] = std::string(ins.func->name) + '(' + text[ins.left] + ')';
+					break;
+				case Op::Polynomial: {
+					T const* coefficients = m_constants.data() + ins.constant;
+					std::string const arg = wrap(text[ins.left], precedence[ins.left], Product + 1);
+					std::string horner = numberToString(coefficients[0]);
+					int hornerPrecedence = horner[0] == '-' ? Sign : Atom;
+					for (int k = 1; k <= ins.power; ++k) {
+						// a leading 1 is left out
+						horner = k == 1 && coefficients[0] == T(1) ? arg : wrap(horner, hornerPrecedence, Product) + '*' + arg;
+						hornerPrecedence = Product;
+						if (coefficients[k] < T()) {
+							horner += '-' + numberToString(-coefficients[k]);
+							hornerPrecedence = Sum;
+						}
+						else if (coefficients[k] != T()) {
+							horner += '+' + numberToString(coefficients[k]);
+							hornerPrecedence = Sum;
+						}
+					}
+					text[i] = horner;
+					precedence[i] = hornerPrecedence;
+					break;
+				}
+				}
+			}
+			return text[m_result];
+		}
+
+	private:
+
+		// Linear scan over the instructions: an operation takes the register of an operand that
+		// dies with it when there is one, every operation may write over its operands.
+		void allocateRegisters() {
+			int const n = size();
+			std::vector<int> lastUse(n, -1);
+			for (int i = 0; i < n; ++i) {
+				if (m_code[i].left >= 0) lastUse[m_code[i].left] = i;
+				if (m_code[i].right >= 0) lastUse[m_code[i].right] = i;
+			}
+			lastUse[m_result] = n;
+
+			std::vector<int> freeRegisters;
+			m_register.assign(n, -1);
+			m_registers = 0;
+			for (int i = 0; i < n; ++i) {
+				Instruction const& ins = m_code[i];
+				if (ins.op == Op::Argument) continue;
+				if (ins.op == Op::Constant) {
+					m_register[i] = m_registers++;
+					continue;
+				}
+				for (int operand : { ins.left, ins.right }) {
+					if (operand < 0 || lastUse[operand] != i || (operand == ins.right && ins.right == ins.left)) continue;
+					Op const operandOp = m_code[operand].op;
+					if (operandOp != Op::Argument && operandOp != Op::Constant) freeRegisters.push_back(m_register[operand]);
+				}
+				if (freeRegisters.empty()) {
+					m_register[i] = m_registers++;
+				}
+				else {
+					m_register[i] = freeRegisters.back();
+					freeRegisters.pop_back();
+				}
+			}
+		}
+
+		std::vector<Instruction> m_code;
+		// coefficients of the instructions
+		std::vector<T> m_constants;
+		// register of every instruction, -1 for the argument
+		std::vector<int> m_register;
+		int m_result;
+		int m_registers;
+
+	};
+
+	// Collects the instructions of a tape. Equal instructions on equal operands are merged,
+	// so structurally identical subtrees become one instruction; operations on constants are
+	// computed here and become constants themselves.
+	template <typename T>
+	class TapeBuilder {
+
+		using Instruction = _TapeInternal::Instruction<T>;
+		using Op = _TapeInternal::Op;
+
+	public:
+
+		int argument() {
+			return push({ Op::Argument, -1, -1, 0, -1, nullptr });
+		}
+
+		int constant(T const& value) {
+			return push({ Op::Constant, -1, -1, 0, -1, nullptr }, &value, 1);
+		}
+
+		int add(int left, int right) {
+			if (isConstant(left) && isConstant(right)) return constant(valueOf(left) + valueOf(right));
+			return push({ Op::Add, std::min(left, right), std::max(left, right), 0, -1, nullptr });
+		}
+
+		int subtract(int left, int right) {
+			if (isConstant(left) && isConstant(right)) return constant(valueOf(left) - valueOf(right));
+			return push({ Op::Subtract, left, right, 0, -1, nullptr });
+		}
+
+		int multiply(int left, int right) {
+			if (isConstant(left) && isConstant(right)) return constant(valueOf(left) * valueOf(right));
+			return push({ Op::Multiply, std::min(left, right), std::max(left, right), 0, -1, nullptr });
+		}
+
+		int divide(int left, int right) {
+			if (isConstant(left) && isConstant(right)) return constant(valueOf(left) / valueOf(right));
+			return push({ Op::Divide, left, right, 0, -1, nullptr });
+		}
+
+		int negate(int operand) {
+			if (isConstant(operand)) return constant(-valueOf(operand));
+			if (m_code[operand].op == Op::Negate) return m_code[operand].left;
+			return push({ Op::Negate, operand, -1, 0, -1, nullptr });
+		}
+
+		int power(int operand, int power) {
+			if (power == 1) return operand;
+			if (isConstant(operand) || power == 0) {
+				T value = T(1);
+				T const base = isConstant(operand) ? valueOf(operand) : T(1);
+				_TapeInternal::power(&base, &value, 1, power);
+				return constant(value);
+			}
+			return push({ Op::Power, operand, -1, power, -1, nullptr });
+		}
+
+		// Func is the tag of an elementary function of Function.h
+		template <typename Func>
+		int unary(int operand) {
+			if (isConstant(operand)) return constant(Func::apply(valueOf(operand)));
+			return push({ Op::Unary, operand, -1, 0, -1, _TapeInternal::unaryFunc<Func, T>() });
+		}
+
+		// coefficients from the highest power down, as in PolynomicFunction
+		int polynomial(int operand, T const* coefficients, int degree) {
+			if (degree == 0) return constant(coefficients[0]);
+			if (degree == 1 && coefficients[0] == T(1) && coefficients[1] == T()) return operand;
+			if (isConstant(operand)) {
+				using std::fma;
+				T value = coefficients[0];
+				for (int i = 1; i <= degree; ++i) { value = fma(value, valueOf(operand), coefficients[i]); }
+				return constant(value);
+			}
+			return push({ Op::Polynomial, operand, -1, degree, -1, nullptr }, coefficients, degree + 1);
+		}
+
+		bool isConstant(int value) const {
+			return m_code[value].op == Op::Constant;
+		}
+
+		// the value of a constant instruction
+		T const& valueOf(int value) const {
+			return m_constants[m_code[value].constant];
+		}
+
+		// the tape computing the instruction result, without the instructions it does not need
+		Tape<T> finish(int result) const {
+			int const n = static_cast<int>(m_code.size());
+			std::vector<bool> live(n, false);
+			live[result] = true;
+			for (int i = result; i >= 0; --i) {
+				if (!live[i]) continue;
+				if (m_code[i].left >= 0) live[m_code[i].left] = true;
+				if (m_code[i].right >= 0) live[m_code[i].right] = true;
+			}
+
+			Tape<T> tape;
+			tape.m_code.clear();
+			std::vector<int> index(n, -1);
+			for (int i = 0; i < n; ++i) {
+				if (!live[i]) continue;
+				Instruction ins = m_code[i];
+				if (ins.left >= 0) ins.left = index[ins.left];
+				if (ins.right >= 0) ins.right = index[ins.right];
+				if (ins.constant >= 0) {
+					int const values = ins.op == Op::Polynomial ? ins.power + 1 : 1;
+					int const constant = static_cast<int>(tape.m_constants.size());
+					tape.m_constants.insert(tape.m_constants.end(), m_constants.begin() + ins.constant, m_constants.begin() + ins.constant + values);
+					ins.constant = constant;
+				}
+				index[i] = tape.size();
+				tape.m_code.push_back(ins);
+			}
+			tape.m_result = index[result];
+			tape.allocateRegisters();
+			return tape;
+		}
+
+	private:
+
+		// the index of an equal instruction on equal values, or of the new one;
+		// a linear search is enough for expressions written by hand
+		int push(Instruction ins, T const* values = nullptr, int count = 0) {
+			for (int i = 0, n = static_cast<int>(m_code.size()); i < n; ++i) {
+				Instruction const& other = m_code[i];
+				if (other.op != ins.op || other.left != ins.left || other.right != ins.right || other.power != ins.power || other.func != ins.func) continue;
+				if (count == 0 || std::equal(values, values + count, m_constants.begin() + other.constant)) return i;
+			}
+			if (count > 0) {
+				ins.constant = static_cast<int>(m_constants.size());
+				m_constants.insert(m_constants.end(), values, values + count);
+			}
+			m_code.push_back(ins);
+			return static_cast<int>(m_code.size()) - 1;
+		}
+
+		std::vector<Instruction> m_code;
+		std::vector<T> m_constants;
+
+	};
+
+	// One time build step from a Function.h expression: identical subexpressions are merged and
+	// constant subexpressions folded, the tape then evaluates each distinct one once per argument.
+	template <typename Func>
+	Tape<_FunctionInternal::ValueOf<Func>> compile(Func const& func) {
+		TapeBuilder<_FunctionInternal::ValueOf<Func>> builder;
+		int const result = func.emit(builder);
+		return builder.finish(result);
+	}
+
+}
+
+#endif // !_BICYCLE_TAPE_H_
@@ -0,0 +1,192 @@
+#ifndef _BICYCLE_TAPE_PARSER_H_
+#define _BICYCLE_TAPE_PARSER_H_
+
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <string>
+
+#include "Tape.h"
+
+namespace bm {
+
+	namespace _TapeParserInternal {
+
+		// larger constant exponents go through exp and log
+		constexpr int MaxIntegerExponent = 1 << 20;
+
+		// Recursive descent over
+		//   sum     = product { ("+" | "-") product }
+		//   product = sign { ("*" | "/") sign }
+		//   sign    = ("-" | "+") sign | power
+		//   power   = atom [ "^" sign ]
+		//   atom    = number | "x" | "pi" | "e" | name "(" sum ")" | "(" sum ")"
+		// straight into a TapeBuilder, so equal subexpressions of the text are merged and
+		// constant ones folded as for compiled expressions. Every rule returns -1 on an error.
+		template <typename T>
+		class Parser {
+
+			using Unary = int (TapeBuilder<T>::*)(int);
+
+			struct NamedFunction {
+				char const* name;
+				Unary unary;
+			};
+
+		public:
+
+			explicit Parser(std::string const& text) : m_text(text), m_pos(0), m_errorPos(0) { }
+
+			bool parse(Tape<T>& tape, std::string* error) {
+				int result = sum();
+				skipSpaces();
+				if (result >= 0 && m_pos != m_text.size()) result = fail("unexpected '" + m_text.substr(m_pos, 1) + "'");
+				if (result < 0) {
+					if (error) *error = m_error + " at " + std::to_string(m_errorPos);
+					return false;
+				}
+				tape = m_builder.finish(result);
+				return true;
+			}
+
+		private:
+
+			int sum() {
+				int left = product();
+				while (left >= 0) {
+					if (accept('+')) left = binary(left, product(), &TapeBuilder<T>::add);
+					else if (accept('-')) left = binary(left, product(), &TapeBuilder<T>::subtract);
+					else break;
+				}
+				return left;
+			}
+
+			int product() {
+				int left = sign();
+				while (left >= 0) {
+					if (accept('*')) left = binary(left, sign(), &TapeBuilder<T>::multiply);
+					else if (accept('/')) left = binary(left, sign(), &TapeBuilder<T>::divide);
+					else break;
+				}
+				return left;
+			}
+
+			int sign() {
+				if (accept('-')) {
+					int const operand = sign();
+					return operand < 0 ? operand : m_builder.negate(operand);
+				}
+				if (accept('+')) return sign();
+				return power();
+			}
+
+			// integer constant exponents become multiplication chains, any other is exp(e * log(base))
+			int power() {
+				int const base = atom();
+				if (base < 0 || !accept('^')) return base;
+				int const exponent = sign();
+				if (exponent < 0) return exponent;
+				if (m_builder.isConstant(exponent)) {
+					T const value = m_builder.valueOf(exponent);
+					bool const small = value >= T(-MaxIntegerExponent) && value <= T(MaxIntegerExponent);
+					if (small && value == T(static_cast<int>(value))) return m_builder.power(base, static_cast<int>(value));
+				}
+				int const logarithm = m_builder.template unary<_FunctionInternal::logTag>(base);
+				return m_builder.template unary<_FunctionInternal::expTag>(m_builder.multiply(exponent, logarithm));
+			}
+
+			int atom() {
+				skipSpaces();
+				if (m_pos == m_text.size()) return fail("unexpected end");
+				char const c = m_text[m_pos];
+				if (std::isdigit(static_cast<unsigned char>(c)) || c == '.') {
+					char const* begin = m_text.c_str() + m_pos;
+					char* end = nullptr;
+					double const value = std::strtod(begin, &end);
+					if (end == begin) return fail("bad number");
+					m_pos += end - begin;
+					return m_builder.constant(T(value));
+				}
+				if (accept('(')) {
+					int const inner = sum();
+					if (inner >= 0 && !accept(')')) return fail("expected ')'");
+					return inner;
+				}
+				if (!std::isalpha(static_cast<unsigned char>(c))) return fail("unexpected '" + std::string(1, c) + "'");
+
+				std::size_t const start = m_pos;
+				while (m_pos < m_text.size() && std::isalnum(static_cast<unsigned char>(m_text[m_pos]))) ++m_pos;
+				std::string const name = m_text.substr(start, m_pos - start);
+				if (name == "x" || name == "X") return m_builder.argument();
+				if (name == "pi") return m_builder.constant(T(3.14159265358979323846));
+				if (name == "e") return m_builder.constant(T(2.71828182845904523536));
+				// the elementary functions of Function.h
+				using namespace _FunctionInternal;
+				static NamedFunction const functions[] = {
+					{ sinTag::name, &TapeBuilder<T>::template unary<sinTag> },
+					{ cosTag::name, &TapeBuilder<T>::template unary<cosTag> },
+					{ tanTag::name, &TapeBuilder<T>::template unary<tanTag> },
+					{ expTag::name, &TapeBuilder<T>::template unary<expTag> },
+					{ logTag::name, &TapeBuilder<T>::template unary<logTag> },
+					{ log10Tag::name, &TapeBuilder<T>::template unary<log10Tag> },
+					{ sqrtTag::name, &TapeBuilder<T>::template unary<sqrtTag> },
+					{ sinhTag::name, &TapeBuilder<T>::template unary<sinhTag> },
+					{ coshTag::name, &TapeBuilder<T>::template unary<coshTag> },
+					{ tanhTag::name, &TapeBuilder<T>::template unary<tanhTag> },
+					{ atanTag::name, &TapeBuilder<T>::template unary<atanTag> },
+					{ absTag::name, &TapeBuilder<T>::template unary<absTag> },
+				};
+				for (NamedFunction const& function : functions) {
+					if (name != function.name) continue;
+					if (!accept('(')) return fail("expected '(' after " + name);
+					int const operand = sum();
+					if (operand < 0) return operand;
+					if (!accept(')')) return fail("expected ')'");
+					return (m_builder.*function.unary)(operand);
+				}
+				m_pos = start;
+				return fail("unknown name " + name);
+			}
+
+			int binary(int left, int right, int (TapeBuilder<T>::*op)(int, int)) {
+				return right < 0 ? right : (m_builder.*op)(left, right);
+			}
+
+			bool accept(char c) {
+				skipSpaces();
+				if (m_pos == m_text.size() || m_text[m_pos] != c) return false;
+				++m_pos;
+				return true;
+			}
+
+			void skipSpaces() {
+				while (m_pos < m_text.size() && std::isspace(static_cast<unsigned char>(m_text[m_pos]))) ++m_pos;
+			}
+
+			int fail(std::string const& message) {
+				m_error = message;
+				m_errorPos = m_pos;
+				return -1;
+			}
+
+			std::string const& m_text;
+			std::size_t m_pos;
+			std::size_t m_errorPos;
+			std::string m_error;
+			TapeBuilder<T> m_builder;
+
+		};
+
+	};
+
+	// Reads an expression in x like "sin(x)*exp(-x)+3*x^2" into tape; Tape::toString() gives text
+	// this reads back. On a syntax error tape is left as it was, false is returned and error
+	// (when given) tells what and where.
+	template <typename T>
+	bool parse(std::string const& text, Tape<T>& tape, std::string* error = nullptr) {
+		return _TapeParserInternal::Parser<T>(text).parse(tape, error);
+	}
+
+}
+
+#endif // !_BICYCLE_TAPE_PARSER_H_
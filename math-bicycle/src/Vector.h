@@ -5,6 +5,9 @@
 #include <string>
 #include <cmath>
 #include <cassert>
+#include <utility>
+
+#include "Reduction.h"
 
 namespace bm {
 
@@ -20,6 +23,17 @@ namespace bm {
 		return res; \
 	}
 
+	// Vector<Len, T> OP Vector<Len, OtherT> computed directly in the common type of T and OtherT
+	#define MIXED_BINARY_OPERATOR(OP) \
+	template <typename OtherT, typename = std::enable_if_t<!std::is_same<T, OtherT>::value>> \
+	auto operator OP(Vector<Len, OtherT> const& other) const { \
+		Vector<Len, std::common_type_t<T, OtherT>> res; \
+		for (int i = 0; i < Len; ++i) { \
+			res[i] = this->vals[i] OP other.at(i); \
+		} \
+		return res; \
+	}
+
 	#define VECTOR_ASSIGN_OPERATOR(Len) \
 	Vector & operator=(Vector const& another) { \
 		for (int i = 0; i < Len; ++i) { vals[i] = T(another.vals[i]); } \
@@ -54,6 +68,10 @@ namespace bm {
 				static_assert(sizeof...(args) == Len, "Number of vector constructor arguments should be equal to its length.");
 			}
 
+			// element type conversion straight into vals, without a temporary array
+			template <typename FromType>
+			explicit VectorBase(Vector<Len, FromType> const& other) : VectorBase(other, std::make_index_sequence<Len>()) { }
+
 			#define TEMPLATE_VECTOR Vector<Len, T>
 			BINARY_OPERATOR(+, TEMPLATE_VECTOR, .vals[i]);
 			BINARY_OPERATOR(-, TEMPLATE_VECTOR, .vals[i]);
@@ -65,6 +83,19 @@ namespace bm {
 			BINARY_OPERATOR(-, T);
 			#undef TEMPLATE_VECTOR
 
+			MIXED_BINARY_OPERATOR(+);
+			MIXED_BINARY_OPERATOR(-);
+			MIXED_BINARY_OPERATOR(*);
+			MIXED_BINARY_OPERATOR(/);
+
+			T const* data() const {
+				return vals;
+			}
+
+			T* data() {
+				return vals;
+			}
+
 			T const &at(int index) const {
 				assert(index >= 0 && index < Len);
 				return vals[index];
@@ -75,16 +106,14 @@ namespace bm {
 				return vals[index];
 			}
 
+			template <Reduction Mode = Reduction::Sequential>
 			auto dot(Vector<Len, T> const &other) const {
-				auto res = this->vals[0] * other.vals[0];
-				for (int i = 1; i < Len; ++i) res = std::fma(this->vals[i], other.vals[i], res);
-				return res;
+				return simd::dot<Mode>(this->vals, other.vals, Len);
 			}
 
+			template <Reduction Mode = Reduction::Sequential>
 			auto norm() const {
-				auto squaresSum = vals[0] * vals[0];
-				for (int i = 1; i < Len; ++i) { squaresSum += vals[i] * vals[i]; }
-				return std::sqrt(squaresSum);
+				return simd::norm<Mode>(vals, Len);
 			}
 
 			bool operator==(Vector<Len, T> const& other) const {
@@ -102,6 +131,11 @@ namespace bm {
 
 			T vals[Len];
 
+		private:
+
+			template <typename FromType, std::size_t ...I>
+			VectorBase(Vector<Len, FromType> const& other, std::index_sequence<I...>) : vals{ T(other.at(I))... } { }
+
 		};
 
 	};
@@ -111,6 +145,8 @@ namespace bm {
 
 		using _VectorInternal::VectorBase<Len, T>::VectorBase;
 
+		Vector(Vector const& other) = default;
+
 		VECTOR_ASSIGN_OPERATOR(Len);
 
 	};
@@ -200,11 +236,20 @@ namespace bm {
 		return true;
 	}
 
+	// converts like simd::convert, so floats going to unsigned char or short saturate
 	template <typename ToType, typename FromType, int Len>
 	Vector<Len, ToType> changeT(Vector<Len, FromType> const& fromVec) {
-		ToType initArray[Len] = { ToType() };
-		for (int i = 0; i < Len; ++i) initArray[i] = fromVec.at(i);
-		return Vector<Len, ToType>(initArray);
+		Vector<Len, ToType> res;
+		simd::convert(fromVec.data(), res.data(), Len);
+		return res;
+	}
+
+	// converts count vectors at once, e.g. a whole buffer of colors, with the same saturation
+	template <typename ToType, typename FromType, int Len>
+	void changeT(Vector<Len, FromType> const* fromVecs, Vector<Len, ToType>* toVecs, int count) {
+		simd::convertObjects<ToType, FromType>(
+			count, Len, [fromVecs](int i) { return fromVecs[i].data(); }, [toVecs](int i) { return toVecs[i].data(); }
+		);
 	}
 
 	using Vector4f = Vector<4, float>;
@@ -224,6 +269,7 @@ namespace bm {
 	using Vector2ui = Vector<2, unsigned int>;
 
 	#undef BINARY_OPERATOR
+	#undef MIXED_BINARY_OPERATOR
 	#undef VECTOR_ASSIGN_OPERATOR
 };
 
@@ -6,6 +6,7 @@
 #include <cmath>
 #include <string>
 
+#include "../AABB.h"
 #include "../Color.h"
 #include "../Point.h"
 #include "../Vector.h"
@@ -90,29 +91,10 @@ namespace bm {
 			bool const isFromPointInRange = isInImageRange(from), isToPointInRange = isInImageRange(to);
 			if (isFromPointInRange && isToPointInRange) {
 				drawLineInRange(from.x, to.x, from.y, to.y, color);
-			} else if (isCrossImageBounds(from, to)) {
-				int const cornersSequense[] = { 0, 1, 2, 3, 0 };
-				Point2f corners[] = { Point2f(0, 0), Point2f(m_width - 1, 0), Point2f(m_width - 1, m_height - 1), Point2f(0, m_height - 1) };
-				Point2f fromf = changeT<float>(from), tof = changeT<float>(to);
-				std::vector<Point2i> intersectionPoints;
-				for (int i = 0; i < 4; ++i) {
-					if (isCrossLine(fromf, tof, corners[i], corners[i + 1])) {
-						auto lineVec = Vector<3>(fromf - tof);
-						auto boundVec = Vector<3>(corners[i] - corners[i + 1]);
-						auto prodVec1 = boundVec.cross(Vector<3>(tof - corners[i]));
-						auto prodVec2 = boundVec.cross(Vector<3>(fromf - corners[i]));
-						intersectionPoints.emplace_back(
-							std::round(tof.x + lineVec.x * std::fabs(prodVec1.z) / std::fabs(prodVec2.z - prodVec1.z)),
-							std::round(tof.y + lineVec.y * std::fabs(prodVec1.z) / std::fabs(prodVec2.z - prodVec1.z))
-						);
-					}
-				}
-				if (intersectionPoints.size() == 2) {
-					auto ip1 = intersectionPoints[0], ip2 = intersectionPoints[1];
-					drawLineInRange(ip1.x, ip2.x, ip1.y, ip2.y, color);
-				} else if (intersectionPoints.size() == 1) {
-					auto ip1 = intersectionPoints[0], ip2 = isFromPointInRange ? from : to;
-					drawLineInRange(ip1.x, ip2.x, ip1.y, ip2.y, color);
+			} else {
+				Point2f fromf(from), tof(to);
+				if (AABB2f(Point2f(0, 0), Point2f(m_width - 1, m_height - 1)).clipSegment(fromf, tof)) {
+					drawLineInRange(std::round(fromf.x), std::round(tof.x), std::round(fromf.y), std::round(tof.y), color);
 				}
 			}
 		}
@@ -268,21 +250,6 @@ namespace bm {
 
 		}
 
-		bool isCrossLine(Point2f const& from1, Point2f const& to1, Point2f const& from2, Point2f const& to2) const {
-			auto checkProducts = [](Vector3f const& prodVec1, Vector3f const& prodVec2) { return std::signbit(prodVec1.z) != std::signbit(prodVec2.z); };
-			auto vec1 = Vector<3>(to1 - from1), vec2 = Vector<3>(to2 - from2);
-			return
-				checkProducts(vec1.cross(Vector<3>(to1 - from2)), vec1.cross(Vector<3>(to1 - to2))) &&
-				checkProducts(vec2.cross(Vector<3>(to2 - from1)), vec2.cross(Vector<3>(to2 - to1)));
-		}
-
-		bool isCrossImageBounds(Point2i const& from, Point2i const& to) const {
-			Point2f topLeft(0, 0), topRight(m_width - 1, 0), bottomLeft(0, m_height - 1), bottomRight(m_width - 1, m_height - 1), fromf = changeT<float>(from), tof = changeT<float>(to);
-			return
-				isCrossLine(fromf, tof, topLeft, topRight) || isCrossLine(fromf, tof, topLeft, bottomLeft) ||
-				isCrossLine(fromf, tof, topRight, bottomRight) || isCrossLine(fromf, tof, bottomLeft, bottomRight);
-		}
-
 		bool isInImageRange(Point2i const& point) const {
 			return isInXRange(point) && isInYRange(point);
 		}
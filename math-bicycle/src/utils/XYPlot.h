@@ -8,12 +8,37 @@
 #include <map>
 #include <limits>
 #include <sstream>
+#include <type_traits>
+#include "../AABB.h"
+#include "../Interval.h"
+#include "../RationalFunction.h"
 #include "./Image.h"
 
 namespace bm {
 
 	using uchar = unsigned char;
 
+	namespace _XYPlotInternal {
+
+		// curves with evaluate(T const*, T*, int) (Function.h composites, polynomials) are sampled in batches
+		template <typename Curve, typename T, typename = void>
+		struct HasEvaluate : std::false_type { };
+
+		template <typename Curve, typename T>
+		struct HasEvaluate<Curve, T, std::void_t<decltype(std::declval<Curve const&>().evaluate(std::declval<T const*>(), std::declval<T*>(), 0))>> : std::true_type { };
+
+		// curves that also evaluate on an Interval argument and so bound whole pieces of the plot
+		template <typename Curve>
+		constexpr bool HasIntervalBound = _FunctionInternal::IsNode<Curve>::value || _FunctionInternal::IsPolynomial<Curve>;
+
+		template <typename T, int NUMERATOR, int DENOMINATOR>
+		constexpr bool HasIntervalBound<RationalFunction<T, NUMERATOR, DENOMINATOR>> = true;
+
+		// times a segment is split in halves at most
+		constexpr int MaxRefinement = 4;
+
+	};
+
 	enum class GridType {
 		Vertical,
 		Horizontal,
@@ -23,7 +48,9 @@ namespace bm {
 	template <typename T>
 	struct XYPlot : public Image<uchar> {
 
-		using XYPlotCurve = std::function<T(T)>;
+		using XYPlotCurve = std::function<void(T const*, T*, int)>;
+
+		using XYPlotBound = std::function<Interval<T>(Interval<T> const&)>;
 
 		XYPlot(int w, int h) : Image<uchar>::Image(w, h, ColorRGB(255, 255, 255)) { }
 
@@ -31,8 +58,20 @@ namespace bm {
 
 		XYPlot(std::string const& path) : Image<uchar>::Image(path) { }
 
-		void addCurve(std::string const &name, XYPlotCurve const& curve, ColorRGB const &color) {
-			m_curvesMap.emplace(name, XYPlotCurveData(curve, color));
+		template <typename Curve>
+		void addCurve(std::string const &name, Curve const& curve, ColorRGB const &color) {
+			XYPlotBound bound;
+			if constexpr (_XYPlotInternal::HasIntervalBound<Curve>) {
+				bound = [curve](Interval<T> const& xs) { return Interval<T>(curve(xs)); };
+			}
+			if constexpr (_XYPlotInternal::HasEvaluate<Curve, T>::value) {
+				m_curvesMap.emplace(name, XYPlotCurveData([curve](T const* xs, T* ys, int count) { curve.evaluate(xs, ys, count); }, bound, color));
+			}
+			else {
+				m_curvesMap.emplace(name, XYPlotCurveData([curve](T const* xs, T* ys, int count) {
+					for (int i = 0; i < count; ++i) ys[i] = curve(xs[i]);
+				}, bound, color));
+			}
 		}
 
 		void addTarget(T x, T y, ColorRGB const& color) {
@@ -73,21 +112,20 @@ namespace bm {
 
 			int values = std::round(std::sqrt(m_height * m_height + m_width * m_width));
 			std::vector<std::vector<T>> results;
-			T minRes = INFINITY;
-			T maxRes = -INFINITY;
+			AABB<1, T> yRange;
 			T const step = (m_xEnd - m_xStart) / (values - 1);
 
+			std::vector<T> xs(values);
+			for (int j = 0; j < values; ++j) xs[j] = m_xStart + j * step;
+
 			for (auto const& [name, curveData] : m_curvesMap) {
 				auto& resultsVector = results.emplace_back(values);
-				for (int j = 0; j < values; ++j) {
-					T resI = resultsVector[j] = curveData.func(m_xStart + j * step);
-					if (resI < minRes) { minRes = resI; }
-					else if (maxRes < resI) { maxRes = resI; }
-				}
+				curveData.func(xs.data(), resultsVector.data(), values);
+				yRange = yRange.merge(AABB<1, T>::fromCoords(resultsVector.data(), values));
 			}
 
-			m_yStart = std::max(minRes, m_yMin);
-			m_yEnd = std::min(maxRes, m_yMax);
+			m_yStart = std::max(yRange.min.at(0), m_yMin);
+			m_yEnd = std::min(yRange.max.at(0), m_yMax);
 			m_xScale = (m_width - 1.0) / (m_xEnd - m_xStart);
 			m_yScale = (m_height - 1.0) / (m_yEnd - m_yStart);
 			{
@@ -111,9 +149,7 @@ namespace bm {
 						T currRes = resultsVec[j];
 						T nextRes = resultsVec[j + 1];
 						if (!isnan(currRes) && !isnan(nextRes)) {
-							Point<3, T> fromWorld(m_xStart + j * xStep, resultsVec[j], 1);
-							Point<3, T> toWorld(m_xStart + (j + 1) * xStep, resultsVec[(j + 1)], 1);
-							drawLine(toImage(fromWorld), toImage(toWorld), curveData.color);
+							drawSegment(curveData, m_xStart + j * xStep, currRes, m_xStart + (j + 1) * xStep, nextRes, 0);
 						}
 					}
 					++i;
@@ -127,8 +163,10 @@ namespace bm {
 	protected:
 
 		struct XYPlotCurveData {
-			XYPlotCurveData(XYPlotCurve const &func, ColorRGB const &color) : func(func), color(color) { }
+			XYPlotCurveData(XYPlotCurve const &func, XYPlotBound const& bound, ColorRGB const &color) : func(func), bound(bound), color(color) { }
 			XYPlotCurve func;
+			// empty for curves without interval evaluation
+			XYPlotBound bound;
 			ColorRGB color;
 		};
 
@@ -148,6 +186,29 @@ namespace bm {
 			GridType type;
 		};
 
+		// With the interval bound of the curve over the segment, a segment lying wholly outside
+		// the visible range is skipped and one whose curve leaves its straight line by more than
+		// a pixel is split at the middle, so narrow peaks between samples are drawn.
+		void drawSegment(XYPlotCurveData const& curveData, T x0, T y0, T x1, T y1, int depth) {
+			if (curveData.bound) {
+				Interval<T> const range = curveData.bound(Interval<T>(x0, x1));
+				if (range.hi < m_yStart || range.lo > m_yEnd) return;
+				T const pixel = T(1) / m_yScale;
+				bool const leavesLine = range.lo < std::min(y0, y1) - pixel || range.hi > std::max(y0, y1) + pixel;
+				if (leavesLine && depth < _XYPlotInternal::MaxRefinement) {
+					T const xMiddle = (x0 + x1) / 2;
+					T yMiddle;
+					curveData.func(&xMiddle, &yMiddle, 1);
+					if (!isnan(yMiddle)) {
+						drawSegment(curveData, x0, y0, xMiddle, yMiddle, depth + 1);
+						drawSegment(curveData, xMiddle, yMiddle, x1, y1, depth + 1);
+						return;
+					}
+				}
+			}
+			drawLine(toImage(Point<3, T>(x0, y0, 1)), toImage(Point<3, T>(x1, y1, 1)), curveData.color);
+		}
+
 		void drawTargets() {
 			for (const auto& target : m_targets) {
 				drawTarget(target.x, target.y, target.color);
@@ -273,7 +334,7 @@ namespace bm {
 		T m_xScale = 1.0f;
 		T m_yScale = 1.0f;
 		T m_yMax = std::numeric_limits<T>::max();
-		T m_yMin = std::numeric_limits<T>::min();
+		T m_yMin = std::numeric_limits<T>::lowest();
 
 		Matrix<3, 3, T> m_worldToImage;
 
@@ -2,38 +2,26 @@
 
 #include <cmath>
 #include <random>
-#include <chrono>
 #include <type_traits>
 #include <iostream>
 
 #include "../../src/Matrix.h"
+#include "../../src/Random.h"
 #include "../../src/Vector.h"
 
 using namespace bm;
 
-// TODO: make same api for matrix, probably move to common.h
-template <int N, typename ToFill>
-ToFill& fillRand(ToFill& toFill, float min = -1.0f, float max = 1.0f) {
-	unsigned seed = std::chrono::system_clock::now().time_since_epoch().count();
-	std::default_random_engine generator(seed);
-	std::normal_distribution<float> distribution((min + max) / 2.0f, max);
-
-	for (int i = 0; i < N; ++i) { toFill[i] = distribution(generator); }
-
-	return toFill;
-};
-
 template <int N>
 struct BlackBox {
 
-	BlackBox() {
+	explicit BlackBox(std::uint64_t seed = std::random_device{}()) : m_generator(seed) {
 		float const precision = 1e-5f;
 		float det = 0;
 		do {
-			for (int i = 0; i < N; ++i) fillRand<N>(m_A.row(i), -10, 10);
+			m_generator.normal(m_A, 0.0f, 10.0f);
 			det = m_A.det();
 		} while (det < precision && det > -precision);
-		fillRand<N>(m_B);
+		m_generator.normal(m_B);
 	}
 
 
@@ -43,6 +31,7 @@ struct BlackBox {
 
 private:
 
+	random::Generator m_generator;
 	Matrix<N, N, float> m_A;
 	Vector<N, float> m_B;
 
@@ -51,25 +40,26 @@ private:
 template <int N>
 struct RandomInBlackBox {
 
-	RandomInBlackBox() {
+	explicit RandomInBlackBox(std::uint64_t seed = std::random_device{}()) : m_generator(seed) {
 		float const precision = 1e-5f;
 		float det = 0;
 		do {
-			for (int i = 0; i < N; ++i) fillRand<N>(m_A.row(i));
+			m_generator.normal(m_A);
 			det = m_A.det();
 		} while (det < precision && det > -precision);
-		fillRand<N>(m_B);
+		m_generator.normal(m_B);
 	}
 
 
 	void get(Vector<N, float> & in, Vector<N, float> & out) const {
 		// TODO: add copy assigment operator
-		auto res = m_A * fillRand<N>(in) + m_B;
+		auto res = m_A * m_generator.normal(in) + m_B;
 		for (int i = 0; i < N; ++i) out[i] = res[i];
 	}
 
 private:
 
+	mutable random::Generator m_generator;
 	Matrix<N, N, float> m_A;
 	Vector<N, float> m_B;
 
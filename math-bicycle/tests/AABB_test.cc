@@ -0,0 +1,117 @@
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <gtest/gtest.h>
+#include "../src/AABB.h"
+
+using namespace bm;
+
+TEST(AABBTest, BoundsTest) {
+	Point2f const points[] = { Point2f(1.0f, -2.0f), Point2f(-3.0f, 4.0f), Point2f(0.5f, 0.5f), Point2f(2.0f, 1.0f) };
+	AABB2f const box = AABB2f::fromPoints(points, 4);
+	EXPECT_EQ(box.min, Point2f(-3.0f, -2.0f));
+	EXPECT_EQ(box.max, Point2f(2.0f, 4.0f));
+	EXPECT_EQ(box.size(), Vector2f(5.0f, 6.0f));
+	EXPECT_EQ(box.center(), Point2f(-0.5f, 1.0f));
+	for (auto const& point : points) EXPECT_TRUE(box.contains(point));
+	EXPECT_FALSE(box.contains(Point2f(2.5f, 0.0f)));
+
+	float const coords[] = { 1.0f, -2.0f, -3.0f, 4.0f, 0.5f, 0.5f, 2.0f, 1.0f };
+	EXPECT_EQ(AABB2f::fromCoords(coords, 4), box);
+
+	AABB2f const empty;
+	EXPECT_TRUE(empty.isEmpty());
+	EXPECT_FALSE(box.isEmpty());
+	EXPECT_EQ(empty.merge(box), box);
+	EXPECT_TRUE(box.contains(empty));
+	EXPECT_TRUE(AABB2f::fromPoints(points, 0).isEmpty());
+}
+
+TEST(AABBTest, ValueRangeTest) {
+	using Range = AABB<1, double>;
+
+	// the first value is the minimum, the maximum comes later
+	std::vector<double> values = { -5.0, 1.0, 7.5, std::nan(""), 3.0 };
+	for (int i = 0; i < 100; ++i) values.push_back(std::sin(i * 0.1));
+	Range const range = Range::fromCoords(values.data(), static_cast<int>(values.size()));
+	EXPECT_EQ(range.min.at(0), -5.0);
+	EXPECT_EQ(range.max.at(0), 7.5);
+
+	double const infinities[] = { std::numeric_limits<double>::infinity(), 2.0 };
+	EXPECT_EQ(Range::fromCoords(infinities, 2).max.at(0), std::numeric_limits<double>::infinity());
+	EXPECT_TRUE(Range::fromCoords(values.data() + 3, 1).isEmpty());
+}
+
+TEST(AABBTest, ManyPointsTest) {
+	// more points than one gathered block, the extremes of each axis in different blocks
+	std::vector<Point3d> points;
+	for (int i = 0; i < 1000; ++i) points.emplace_back(std::sin(i * 0.37), std::cos(i * 0.11) * i, i == 700 ? std::nan("") : -0.5 * i);
+	AABB3d expected;
+	for (auto const& point : points) expected.expand(point);
+	AABB3d const box = AABB3d::fromPoints(points.data(), static_cast<int>(points.size()));
+	EXPECT_EQ(box, expected);
+	EXPECT_EQ(box.max.at(2), 0.0);
+	EXPECT_EQ(box.min.at(2), -499.5);
+
+	std::vector<double> coords;
+	for (auto const& point : points) coords.insert(coords.end(), point.data(), point.data() + 3);
+	EXPECT_EQ(AABB3d::fromCoords(coords.data(), static_cast<int>(points.size())), box);
+}
+
+TEST(AABBTest, MergeIntersectTest) {
+	AABB3f const a(Point3f(0.0f, 0.0f, 0.0f), Point3f(2.0f, 2.0f, 2.0f));
+	AABB3f const b(Point3f(1.0f, -1.0f, 1.0f), Point3f(3.0f, 1.0f, 4.0f));
+	AABB3f const c(Point3f(5.0f, 5.0f, 5.0f), Point3f(6.0f, 6.0f, 6.0f));
+
+	EXPECT_EQ(a.merge(b), AABB3f(Point3f(0.0f, -1.0f, 0.0f), Point3f(3.0f, 2.0f, 4.0f)));
+	EXPECT_EQ(a.intersection(b), AABB3f(Point3f(1.0f, 0.0f, 1.0f), Point3f(2.0f, 1.0f, 2.0f)));
+	EXPECT_TRUE(a.intersects(b));
+	EXPECT_FALSE(a.intersects(c));
+	EXPECT_TRUE(a.intersection(c).isEmpty());
+	EXPECT_TRUE(a.merge(b).contains(b));
+	EXPECT_FALSE(a.contains(b));
+}
+
+TEST(AABBTest, RaySegmentTest) {
+	AABB2f const box(Point2f(0.0f, 0.0f), Point2f(10.0f, 5.0f));
+	float distance = -1.0f;
+	EXPECT_TRUE(box.intersectsRay(Point2f(-2.0f, 1.0f), Vector2f(1.0f, 0.0f), &distance));
+	EXPECT_FLOAT_EQ(distance, 2.0f);
+	EXPECT_TRUE(box.intersectsRay(Point2f(3.0f, 3.0f), Vector2f(1.0f, 1.0f), &distance));
+	EXPECT_FLOAT_EQ(distance, 0.0f);
+	EXPECT_FALSE(box.intersectsRay(Point2f(-2.0f, 1.0f), Vector2f(-1.0f, 0.0f)));
+	EXPECT_FALSE(box.intersectsRay(Point2f(-2.0f, 6.0f), Vector2f(1.0f, 0.0f)));
+
+	EXPECT_TRUE(box.intersectsSegment(Point2f(-1.0f, -1.0f), Point2f(1.0f, 1.0f)));
+	EXPECT_FALSE(box.intersectsSegment(Point2f(-3.0f, -1.0f), Point2f(-1.0f, 1.0f)));
+	EXPECT_FALSE(box.intersectsSegment(Point2f(-1.0f, 4.5f), Point2f(2.0f, 7.5f)));
+
+	Point2f from(-5.0f, 2.5f), to(15.0f, 2.5f);
+	EXPECT_TRUE(box.clipSegment(from, to));
+	EXPECT_TRUE(equals(from, Point2f(0.0f, 2.5f), 1e-5f));
+	EXPECT_TRUE(equals(to, Point2f(10.0f, 2.5f), 1e-5f));
+
+	Point2f diagonalFrom(-2.0f, -1.0f), diagonalTo(4.0f, 2.0f);
+	EXPECT_TRUE(box.clipSegment(diagonalFrom, diagonalTo));
+	EXPECT_TRUE(equals(diagonalFrom, Point2f(0.0f, 0.0f), 1e-5f));
+	EXPECT_TRUE(equals(diagonalTo, Point2f(4.0f, 2.0f), 1e-5f));
+}
+
+TEST(AABBTest, IntegerRaySegmentTest) {
+	AABB2i const box(Point2i(0, 0), Point2i(10, 10));
+	double distance = -1.0;
+	EXPECT_TRUE(box.intersectsRay(Point2i(-20, 5), Vector2i(4, 0), &distance));
+	EXPECT_DOUBLE_EQ(distance, 5.0);
+	EXPECT_FALSE(box.intersectsRay(Point2i(-20, 5), Vector2i(3, 7)));
+	EXPECT_FALSE(box.intersectsSegment(Point2i(-20, 5), Point2i(-2, 5)));
+
+	Point2i from(-20, 5), to(20, 5);
+	EXPECT_TRUE(box.clipSegment(from, to));
+	EXPECT_EQ(from, Point2i(0, 5));
+	EXPECT_EQ(to, Point2i(10, 5));
+
+	Point2i diagonalFrom(-3, -6), diagonalTo(4, 8);
+	EXPECT_TRUE(box.clipSegment(diagonalFrom, diagonalTo));
+	EXPECT_EQ(diagonalFrom, Point2i(0, 0));
+	EXPECT_EQ(diagonalTo, Point2i(4, 8));
+}
@@ -0,0 +1,87 @@
+#include <cmath>
+#include <vector>
+#include <gtest/gtest.h>
+#include "../src/Chebyshev.h"
+#include "../src/Function.h"
+#include "../src/PolynomicFunction.h"
+
+using namespace bm;
+
+// largest difference from func over a dense grid of [start, end]
+template <typename Approximation, typename Func>
+double maxError(Approximation const& approximation, Func const& func, double start, double end) {
+	int const n = 10000;
+	std::vector<double> args(n + 1), res(n + 1);
+	for (int i = 0; i <= n; ++i) args[i] = start + (end - start) * i / n;
+	approximation.evaluate(args.data(), res.data(), n + 1);
+	double error = 0.0;
+	for (int i = 0; i <= n; ++i) error = std::max(error, std::abs(res[i] - func(args[i])));
+	return error;
+}
+
+TEST(ChebyshevTest, ExpansionTest) {
+	// T_3(t) = 4t^3 - 3t has the single coefficient c_3
+	Chebyshev<double> const t3({ 0.0, 0.0, 0.0, 1.0 }, -1.0, 1.0);
+	EXPECT_EQ(t3.degree(), 3);
+	EXPECT_DOUBLE_EQ(t3(0.5), 4.0 * 0.125 - 1.5);
+	EXPECT_DOUBLE_EQ(t3(-1.0), -1.0);
+
+	// the interpolant through Chebyshev points of a cubic on [2, 5] is the cubic
+	auto const cubic = [](double x) { return x * x * x - 2.0 * x + 1.0; };
+	std::vector<double> values(9);
+	for (int j = 0; j <= 8; ++j) values[j] = cubic(_ChebyshevInternal::point(j, 8, 2.0, 5.0));
+	auto const interpolant = Chebyshev<double>::interpolant(values.data(), 8, 2.0, 5.0);
+	for (int k = 4; k <= 8; ++k) EXPECT_NEAR(interpolant.coefficients()[k], 0.0, 1e-13);
+	EXPECT_LE(maxError(interpolant, cubic, 2.0, 5.0), 1e-12);
+}
+
+TEST(ChebyshevTest, AdaptiveTest) {
+	Xd const X;
+	auto const f = sin(X * 10.0) * exp(X) + X * X / (cosh(X) + 1.0);
+	bool converged = false;
+	auto const expansion = chebyshev(f, -1.0, 2.0, _ChebyshevInternal::MaxDegree, &converged);
+	EXPECT_TRUE(converged);
+	EXPECT_LT(expansion.degree(), 128);
+	EXPECT_LE(maxError(expansion, f, -1.0, 2.0), 1e-13);
+	EXPECT_NEAR(expansion(0.3), f(0.3), 1e-13);
+
+	// Runge's function needs a high degree but gets there
+	auto const runge = [](double x) { return 1.0 / (1.0 + 25.0 * x * x); };
+	auto const rungeExpansion = chebyshev(runge, -1.0, 1.0, _ChebyshevInternal::MaxDegree, &converged);
+	EXPECT_TRUE(converged);
+	EXPECT_GT(rungeExpansion.degree(), 100);
+	EXPECT_LE(maxError(rungeExpansion, runge, -1.0, 1.0), 1e-14);
+
+	// a kink does not converge and stops at the limit
+	auto const kink = [](double x) { return std::abs(x - 0.1); };
+	auto const kinkExpansion = chebyshev(kink, -1.0, 1.0, 512, &converged);
+	EXPECT_FALSE(converged);
+	EXPECT_EQ(kinkExpansion.degree(), 512);
+	EXPECT_LE(maxError(kinkExpansion, kink, -1.0, 1.0), 1e-2);
+}
+
+TEST(ChebyshevTest, PolynomicTest) {
+	double const coefficients[] = { 2.0, -3.0, 0.5, 7.0 };
+	PolynomicFunction<3, double> const poly(coefficients);
+	auto const expansion = chebyshev(poly, -1.0, 3.0);
+	EXPECT_EQ(expansion.degree(), 3);
+
+	// back to the coefficients it came from, into the same or a larger degree
+	auto const back = expansion.toPolynomic<3>();
+	auto const wider = expansion.toPolynomic<5>();
+	for (double x = -1.0; x <= 3.0; x += 0.25) {
+		EXPECT_NEAR(back(x), poly(x), 1e-12);
+		EXPECT_NEAR(wider(x), poly(x), 1e-12);
+	}
+	EXPECT_NEAR(back.derivative()(1.0), poly.derivative()(1.0), 1e-12);
+
+	// exp on a short interval is a polynomial of small degree to machine precision
+	Xd const X;
+	auto const e = chebyshev(exp(X), 0.0, 0.5);
+	EXPECT_LE(e.degree(), 15);
+	auto const taylorLike = e.toPolynomic<15>();
+	for (double x = 0.0; x <= 0.5; x += 0.05) EXPECT_NEAR(taylorLike(x), std::exp(x), 1e-14);
+
+	Chebyshev<double> const constant({ 4.0 }, 0.0, 1.0);
+	EXPECT_EQ(constant.toPolynomic<0>()(0.5), 4.0);
+}
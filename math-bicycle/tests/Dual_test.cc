@@ -0,0 +1,123 @@
+#include <cmath>
+#include <gtest/gtest.h>
+#include "../src/Dual.h"
+#include "../src/Function.h"
+#include "../src/Matrix.h"
+#include "../src/PolynomicFunction.h"
+#include "../src/RationalFunction.h"
+#include "../src/Vector.h"
+
+using namespace bm;
+
+double const precision = 1e-12;
+
+TEST(DualTest, ArithmeticTest) {
+	using Dual2 = Dual<double, 2>;
+	Dual2 const x = Dual2::variable(3.0, 0), y = Dual2::variable(-2.0, 1);
+
+	Dual2 const product = x * y + 2.0 * x - y / 4.0;
+	EXPECT_DOUBLE_EQ(product.value, -6.0 + 6.0 + 0.5);
+	EXPECT_DOUBLE_EQ(product.d[0], -2.0 + 2.0);
+	EXPECT_DOUBLE_EQ(product.d[1], 3.0 - 0.25);
+
+	Dual2 const quotient = x / y;
+	EXPECT_DOUBLE_EQ(quotient.value, -1.5);
+	EXPECT_DOUBLE_EQ(quotient.d[0], -0.5);
+	EXPECT_DOUBLE_EQ(quotient.d[1], -3.0 / 4.0);
+
+	Dual2 const power = pow(x, y);
+	EXPECT_NEAR(power.value, 1.0 / 9.0, precision);
+	EXPECT_NEAR(power.d[0], -2.0 * std::pow(3.0, -3.0), precision);
+	EXPECT_NEAR(power.d[1], std::log(3.0) / 9.0, precision);
+
+	EXPECT_TRUE(x > y);
+	EXPECT_TRUE(x == 3.0);
+	EXPECT_FALSE(Dual2() != 0.0);
+}
+
+TEST(DualTest, MathFunctionsTest) {
+	double const args[] = { 0.3, 1.7, 2.5 };
+	for (double const arg : args) {
+		Duald const x = Duald::variable(arg);
+		EXPECT_NEAR(sin(x).d[0], std::cos(arg), precision);
+		EXPECT_NEAR(cos(x).d[0], -std::sin(arg), precision);
+		EXPECT_NEAR(tan(x).d[0], 1.0 / (std::cos(arg) * std::cos(arg)), 1e-10);
+		EXPECT_NEAR(exp(x).d[0], std::exp(arg), precision);
+		EXPECT_NEAR(log(x).d[0], 1.0 / arg, precision);
+		EXPECT_NEAR(log10(x).d[0], 1.0 / (arg * std::log(10.0)), precision);
+		EXPECT_NEAR(sqrt(x).d[0], 0.5 / std::sqrt(arg), precision);
+		EXPECT_NEAR(sinh(x).d[0], std::cosh(arg), precision);
+		EXPECT_NEAR(cosh(x).d[0], std::sinh(arg), precision);
+		EXPECT_NEAR(tanh(x).d[0], 1.0 / (std::cosh(arg) * std::cosh(arg)), precision);
+		EXPECT_NEAR(atan(x).d[0], 1.0 / (1.0 + arg * arg), precision);
+		EXPECT_NEAR(abs(-x).d[0], 1.0, precision);
+		EXPECT_NEAR(abs(x - 5.0).d[0], -1.0, precision);
+		EXPECT_NEAR(pow(x, 3.0).d[0], 3.0 * arg * arg, 1e-10);
+	}
+
+	// second derivative of x^3 through a dual of duals
+	using Dual2nd = Dual<Duald>;
+	Dual2nd const x = Dual2nd::variable(Duald::variable(2.0));
+	Dual2nd const cube = x * x * x;
+	EXPECT_DOUBLE_EQ(cube.value.value, 8.0);
+	EXPECT_DOUBLE_EQ(cube.d[0].value, 12.0);
+	EXPECT_DOUBLE_EQ(cube.d[0].d[0], 12.0);
+	EXPECT_NEAR(sin(x).d[0].d[0], -std::sin(2.0), precision);
+}
+
+TEST(DualTest, FunctionTest) {
+	X_<Duald> const X;
+	double const coefficients[] = { 2.0, -3.0, 0.5, 7.0 };
+	Duald dualCoefficients[4];
+	for (int i = 0; i < 4; ++i) dualCoefficients[i] = coefficients[i];
+	PolynomicFunction<3, Duald> const poly(dualCoefficients);
+	PolynomicFunction<3, double> const plain(coefficients);
+
+	auto const composite = sin(X) * exp(X) + sqrt(X);
+	auto const rational = RationalFunction<Duald, 2, 1>(X * X + Duald(1.0), X - Duald(3.0));
+
+	double const args[] = { 0.25, 1.0, 2.0 };
+	for (double const arg : args) {
+		Duald const x = Duald::variable(arg);
+
+		Duald const polyRes = poly(x);
+		EXPECT_EQ(polyRes.value, plain(arg));
+		EXPECT_NEAR(polyRes.d[0], 6.0 * arg * arg - 6.0 * arg + 0.5, precision);
+
+		Duald const compositeRes = composite(x);
+		EXPECT_NEAR(compositeRes.value, std::sin(arg) * std::exp(arg) + std::sqrt(arg), precision);
+		EXPECT_NEAR(compositeRes.d[0], (std::cos(arg) + std::sin(arg)) * std::exp(arg) + 0.5 / std::sqrt(arg), precision);
+
+		// ((x^2 + 1) / (x - 3))' = (x^2 - 6x - 1) / (x - 3)^2
+		Duald const rationalRes = rational(x);
+		EXPECT_NEAR(rationalRes.d[0], (arg * arg - 6.0 * arg - 1.0) / ((arg - 3.0) * (arg - 3.0)), precision);
+	}
+}
+
+TEST(DualTest, VectorMatrixTest) {
+	using Dual3 = Dual<double, 3>;
+	using Vector3D = Vector<3, Dual3>;
+	using Matrix2D = Matrix<2, 2, Dual3>;
+
+	// gradient of the norm is the unit vector
+	Vector3D const vec(Dual3::variable(1.0, 0), Dual3::variable(2.0, 1), Dual3::variable(2.0, 2));
+	Dual3 const norm = vec.norm();
+	EXPECT_DOUBLE_EQ(norm.value, 3.0);
+	for (int i = 0; i < 3; ++i) EXPECT_NEAR(norm.d[i], vec.at(i).value / 3.0, precision);
+	Dual3 const dot = vec.dot(vec);
+	for (int i = 0; i < 3; ++i) EXPECT_NEAR(dot.d[i], 2.0 * vec.at(i).value, precision);
+
+	// d det / d a = d, d inv(A) = -inv(A) dA inv(A)
+	using Dual1 = Dual<double>;
+	Matrix<2, 2, Dual1> const mat({ Dual1::variable(2.0), 1.0, 1.0, 3.0 });
+	EXPECT_NEAR(mat.det().value, 5.0, precision);
+	EXPECT_NEAR(mat.det().d[0], 3.0, precision);
+	Matrix<2, 2, Dual1> const inverse = mat.inv();
+	EXPECT_NEAR(inverse.at(0, 0).value, 0.6, precision);
+	EXPECT_NEAR(inverse.at(0, 0).d[0], -0.36, precision);
+	EXPECT_NEAR(inverse.at(1, 1).d[0], -0.04, precision);
+
+	Matrix2D const identity;
+	EXPECT_EQ(identity.at(0, 0), 1.0);
+	EXPECT_EQ(identity.at(0, 1), 0.0);
+}
@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+#include "../src/DynamicMatrix.h"
+
+using namespace bm;
+
+float const precission = 1e-3f, precission_div_2 = precission / 2.0f;
+
+TEST(DynamicMatrixTest, DataAccessTest) {
+	int const Rows = 3;
+	int const Cols = 5;
+	float init_array[Rows * Cols] = {
+		1.1f,  2.2f,  3.3f,  4.4f,  5.5f,
+		6.6f,  7.7f,  8.8f,  9.9f,  10.1f,
+		11.1f, 12.2f, 13.3f, 14.4f, 15.5f
+	};
+	DynamicMatrixf mat(Rows, Cols, init_array);
+	for (int i = 0; i < Rows; ++i) {
+		EXPECT_TRUE(simd::isAligned(&mat.at(i, 0), simd::Layout<float>::alignment));
+		for (int j = 0; j < Cols; ++j) {
+			int const array_index = i * Cols + j;
+			EXPECT_EQ(mat[i][j],		init_array[array_index]);
+			EXPECT_EQ(mat.at(i).at(j), init_array[array_index]);
+			EXPECT_EQ(mat.at(i, j),	init_array[array_index]);
+		}
+	}
+
+	EXPECT_TRUE(equals(DynamicMatrixf(mat.toMatrix<Rows, Cols>()), mat));
+	EXPECT_TRUE(equals(mat.trans().trans(), mat));
+}
+
+TEST(DynamicMatrixTest, MatchesFixedMatrixTest) {
+	int const Dim = 3;
+	float init_array[Dim * Dim] = {
+		1.1f, 7.7f,   14.14f,
+		4.4f, 22.22f, 6.6f,
+		7.7f, 12.12f, 9.9f
+	};
+	float changing_array[Dim * Dim] = {
+		9.9f, 8.8f, 7.7f,
+		6.6f, 5.5f, 4.4f,
+		3.3f, 2.2f, 1.1f
+	};
+	float const scale = 17.17f;
+	Matrix<Dim, Dim, float> mat3f(init_array), changing_mat3f(changing_array);
+	DynamicMatrixf mat(mat3f), changing_mat(changing_mat3f);
+
+	EXPECT_TRUE(equals((mat + changing_mat).toMatrix<Dim, Dim>(), mat3f + changing_mat3f, precission));
+	EXPECT_TRUE(equals((mat - changing_mat).toMatrix<Dim, Dim>(), mat3f - changing_mat3f, precission));
+	EXPECT_TRUE(equals((mat * changing_mat).toMatrix<Dim, Dim>(), mat3f * changing_mat3f, precission));
+	EXPECT_TRUE(equals((mat * scale).toMatrix<Dim, Dim>(), mat3f * scale, precission));
+	EXPECT_TRUE(equals((mat / scale).toMatrix<Dim, Dim>(), mat3f / scale, precission));
+	EXPECT_TRUE(equals(mat.inv().toMatrix<Dim, Dim>(), mat3f.inv(), precission));
+	EXPECT_NEAR(mat.det(), mat3f.det(), precission);
+
+	Vector3f vec3f(1.1f, 2.2f, 3.3f);
+	EXPECT_TRUE(equals((mat * DynamicVectorf(vec3f)).toVector<Dim>(), mat3f * vec3f, precission));
+}
+
+TEST(DynamicMatrixTest, InversionTest) {
+	int const Dim = 20;
+	DynamicMatrixd mat(Dim, Dim), identity(Dim, Dim);
+	for (int i = 0; i < Dim; ++i) {
+		for (int j = 0; j < Dim; ++j) {
+			mat.at(i, j) = 1.0 / (1 + i + j) + (i == j ? Dim : 0);
+		}
+	}
+
+	EXPECT_TRUE(equals(mat * mat.inv(), identity, 1e-9));
+	EXPECT_TRUE(equals(mat.inv() * mat, identity, 1e-9));
+}
+
+TEST(DynamicMatrixTest, ThreadCountIndependentProductTest) {
+	int const Dim = 150;
+	DynamicMatrixf mat1(Dim, Dim), mat2(Dim, Dim);
+	for (int i = 0; i < Dim; ++i) {
+		for (int j = 0; j < Dim; ++j) {
+			mat1.at(i, j) = std::sin(0.1f * i + j);
+			mat2.at(i, j) = std::cos(0.3f * j - i);
+		}
+	}
+
+	parallel::setThreadCount(1);
+	DynamicMatrixf const product = mat1 * mat2;
+	parallel::setThreadCount(4);
+	DynamicMatrixf const parallelProduct = mat1 * mat2;
+	parallel::setThreadCount(0);
+
+	EXPECT_TRUE(equals(product, parallelProduct));
+}
@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+#include "../src/DynamicVector.h"
+
+using namespace bm;
+
+float const precission = 1e-3f, precission_div_2 = precission / 2.0f;
+
+TEST(DynamicVectorTest, DataAccessTest) {
+	int const Len = 3;
+	float init_array[] = { 1.1f, 2.2f, 3.3f };
+	DynamicVectorf vecf(init_array, Len);
+
+	EXPECT_EQ(vecf.size(), Len);
+	for (int i = 0; i < Len; ++i) {
+		EXPECT_EQ(vecf[i], init_array[i]);
+		EXPECT_EQ(vecf.at(i), init_array[i]);
+	}
+}
+
+TEST(DynamicVectorTest, HeapSpillTest) {
+	int const Len = 100;
+	DynamicVector<float, 8> small(8, 1.0f), big(Len, 2.0f);
+
+	auto big_copy = big;
+	auto moved = std::move(big_copy);
+	for (int i = 0; i < Len; ++i) { EXPECT_EQ(moved[i], 2.0f); }
+	EXPECT_EQ(big_copy.size(), 0);
+
+	small.resize(Len);
+	EXPECT_EQ(small.size(), Len);
+	for (int i = 0; i < Len; ++i) { EXPECT_EQ(small[i], i < 8 ? 1.0f : 0.0f); }
+
+	big.resize(3);
+	EXPECT_TRUE(equals(big, DynamicVector<float, 8>({ 2.0f, 2.0f, 2.0f })));
+}
+
+TEST(DynamicVectorTest, DotProductTest) {
+	int const Len = 40;
+	DynamicVectorf vec1(Len), vec2(Len);
+	float res = 0;
+	for (int i = 0; i < Len; ++i) {
+		vec1[i] = 0.1f * i;
+		vec2[i] = 1.0f - 0.05f * i;
+		res += vec1[i] * vec2[i];
+	}
+
+	EXPECT_NEAR(vec1.dot(vec2), res, precission);
+	EXPECT_NEAR(vec1.norm(), std::sqrt(vec1.dot(vec1)), precission);
+}
+
+TEST(DynamicVectorTest, ArithmeticOperationsTests) {
+	int const Len = 3;
+	float init_array[] = { 1.1f, 2.2f, 3.3f };
+	float changing_array[] = { 3.3f, 4.4f, 5.5f };
+	float const scale = 12.12f;
+
+	Vector<Len, float> vec3f(init_array), changing_vec3f(changing_array);
+	DynamicVectorf vecf(vec3f), changing_vecf(changing_vec3f);
+
+	EXPECT_TRUE(equals((vecf + changing_vecf).toVector<Len>(), vec3f + changing_vec3f, precission));
+	EXPECT_TRUE(equals((vecf - changing_vecf).toVector<Len>(), vec3f - changing_vec3f, precission));
+	EXPECT_TRUE(equals((vecf * changing_vecf).toVector<Len>(), vec3f * changing_vec3f, precission));
+	EXPECT_TRUE(equals((vecf / changing_vecf).toVector<Len>(), vec3f / changing_vec3f, precission));
+	EXPECT_TRUE(equals((vecf * scale).toVector<Len>(), vec3f * scale, precission));
+	EXPECT_TRUE(equals((vecf / scale).toVector<Len>(), vec3f / scale, precission));
+	EXPECT_TRUE(equals((vecf + scale).toVector<Len>(), vec3f + scale, precission));
+	EXPECT_TRUE(equals((vecf - scale).toVector<Len>(), vec3f - scale, precission));
+}
+
+TEST(DynamicVectorTest, ReductionModesTest) {
+	int const Len = 1 << 16;
+	DynamicVectorf vec(Len, 0.1f), ones(Len, 1.0f);
+	double const exact = static_cast<double>(0.1f) * Len;
+
+	float const sequential = vec.dot(ones);
+	float const multiAccumulator = vec.dot<Reduction::MultiAccumulator>(ones);
+	float const pairwise = vec.dot<Reduction::Pairwise>(ones);
+	float const compensated = vec.dot<Reduction::Compensated>(ones);
+
+	EXPECT_GT(std::fabs(sequential - exact), 1.0);
+	EXPECT_NEAR(pairwise, exact, exact * 1e-6);
+	EXPECT_NEAR(compensated, exact, exact * 1e-6);
+	EXPECT_LT(std::fabs(multiAccumulator - exact), std::fabs(sequential - exact));
+	EXPECT_NEAR(vec.norm<Reduction::Compensated>(), std::sqrt(exact * 0.1f), 1e-2);
+}
+
+TEST(DynamicVectorTest, ReproducibleReductionTest) {
+	int const Len = 1 << 18;
+	DynamicVectorf vec1(Len), vec2(Len);
+	for (int i = 0; i < Len; ++i) {
+		vec1[i] = std::sin(0.001f * i);
+		vec2[i] = 1.0f / (1 + i % 97);
+	}
+
+	parallel::setThreadCount(1);
+	float const dot = vec1.dot<Reduction::Reproducible>(vec2);
+	float const norm = vec1.norm<Reduction::Reproducible>();
+	double const parallelDot = vec1.dot<Reduction::Parallel>(vec2);
+	for (int threads : { 2, 3, 7 }) {
+		parallel::setThreadCount(threads);
+		EXPECT_EQ(vec1.dot<Reduction::Reproducible>(vec2), dot);
+		EXPECT_EQ(vec1.norm<Reduction::Reproducible>(), norm);
+		EXPECT_NEAR(vec1.dot<Reduction::Parallel>(vec2), parallelDot, std::fabs(parallelDot) * 1e-4);
+	}
+	parallel::setThreadCount(0);
+
+	EXPECT_NEAR(dot, vec1.dot<Reduction::Compensated>(vec2), std::fabs(dot) * 1e-5);
+}
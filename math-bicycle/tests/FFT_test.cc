@@ -0,0 +1,42 @@
+#include <cmath>
+#include <complex>
+#include <vector>
+#include <gtest/gtest.h>
+#include "../src/FFT.h"
+
+using namespace bm;
+
+using Complex = std::complex<double>;
+
+TEST(FFTTest, TransformTest) {
+	double const pi = 3.14159265358979323846;
+	int const sizes[] = { 1, 2, 8, 64 };
+	for (int const n : sizes) {
+		std::vector<Complex> data(n);
+		for (int j = 0; j < n; ++j) data[j] = Complex(std::sin(j * 0.7) + j, std::cos(j * 1.3));
+		std::vector<Complex> const input = data;
+
+		// against the sums of the definition
+		fft(data.data(), n);
+		for (int k = 0; k < n; ++k) {
+			Complex expected;
+			for (int j = 0; j < n; ++j) expected += input[j] * std::polar(1.0, -2.0 * pi * j * k / n);
+			EXPECT_NEAR(data[k].real(), expected.real(), 1e-10);
+			EXPECT_NEAR(data[k].imag(), expected.imag(), 1e-10);
+		}
+
+		fft(data.data(), n, true);
+		for (int j = 0; j < n; ++j) {
+			EXPECT_NEAR(data[j].real(), input[j].real(), 1e-12);
+			EXPECT_NEAR(data[j].imag(), input[j].imag(), 1e-12);
+		}
+	}
+
+	// a pure tone lands in one bin
+	int const n = 1 << 12;
+	std::vector<std::complex<float>> tone(n);
+	for (int j = 0; j < n; ++j) tone[j] = std::polar(1.f, float(2.0 * pi * 5 * j / n));
+	fft(tone.data(), n);
+	EXPECT_NEAR(tone[5].real(), float(n), 1e-2f * n);
+	EXPECT_NEAR(std::abs(tone[6]), 0.f, 1e-2f);
+}
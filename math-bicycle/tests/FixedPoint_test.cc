@@ -0,0 +1,59 @@
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <gtest/gtest.h>
+#include "../src/FixedPoint.h"
+#include "../src/Matrix.h"
+
+using namespace bm;
+
+TEST(FixedPointTest, ConversionTest) {
+	EXPECT_EQ(Fixed16(1.5f).raw, 384);
+	EXPECT_EQ(float(Fixed16(-2.25f)), -2.25f);
+	EXPECT_EQ(float(Fixed16(0.001f)), 0.0f);
+	EXPECT_EQ(float(Fixed16(0.003f)), 1.0f / 256.0f);
+	// saturation instead of wrap around
+	EXPECT_EQ(Fixed16(1000.0f).raw, std::numeric_limits<std::int16_t>::max());
+	EXPECT_EQ(Fixed16(-1000.0f).raw, std::numeric_limits<std::int16_t>::lowest());
+	EXPECT_EQ(Fixed16(std::nanf("")).raw, std::numeric_limits<std::int16_t>::lowest());
+
+	EXPECT_EQ(double(Fixed32(12345.678)), std::nearbyint(12345.678 * 65536.0) / 65536.0);
+	EXPECT_EQ(Fixed32(1e10).raw, std::numeric_limits<std::int32_t>::max());
+	EXPECT_EQ(double(std::numeric_limits<Fixed32>::epsilon()), 1.0 / 65536.0);
+	EXPECT_EQ(double(std::numeric_limits<Fixed32>::min()), 1.0 / 65536.0);
+	EXPECT_EQ(std::numeric_limits<Fixed16>::lowest().raw, std::numeric_limits<std::int16_t>::lowest());
+
+	for (int raw = -32768; raw < 32768; ++raw) {
+		Fixed16 const value = Fixed16::fromRaw(static_cast<std::int16_t>(raw));
+		EXPECT_EQ(Fixed16(float(value)).raw, value.raw);
+	}
+}
+
+TEST(FixedPointTest, BatchConversionTest) {
+	int const count = 1000;
+	std::vector<float> values(count), back(count);
+	std::vector<Fixed16> fixed(count);
+	for (int i = 0; i < count; ++i) values[i] = std::sin(i * 0.37f) * (i % 200);
+	simd::convert(values.data(), fixed.data(), count);
+	simd::convert(fixed.data(), back.data(), count);
+	for (int i = 0; i < count; ++i) {
+		EXPECT_EQ(fixed[i].raw, Fixed16(values[i]).raw);
+		EXPECT_EQ(back[i], float(fixed[i]));
+	}
+}
+
+TEST(FixedPointTest, VectorMatrixTest) {
+	using Vector3x = Vector<3, Fixed32>;
+	using Matrix2x = Matrix<2, 2, Fixed32>;
+
+	Vector3x const a(1.5, -2.0, 0.25), b(2.0, 0.5, 4.0);
+	EXPECT_TRUE(equals(a + b, Vector3x(3.5, -1.5, 4.25)));
+	EXPECT_EQ(a.dot(b), 3.0);
+	EXPECT_EQ(Vector3x(3.0, 4.0, 0.0).norm(), 5.0);
+
+	Matrix2x const identity;
+	Matrix2x const mat({ 2.0, 1.0, 1.0, 3.0 });
+	EXPECT_EQ(double(identity.at(0, 0)), 1.0);
+	EXPECT_TRUE(equals(mat * mat.inv(), identity, Fixed32(1e-4)));
+	EXPECT_NEAR(mat.det(), 5.0, 1e-4);
+}
@@ -0,0 +1,125 @@
+#include <cmath>
+#include <type_traits>
+#include <vector>
+#include <gtest/gtest.h>
+#include "../src/Function.h"
+#include "../src/PolynomicFunction.h"
+
+using namespace bm;
+
+TEST(FunctionTest, EvaluateTest) {
+	Xd const X;
+	auto const f = sin(X) * exp(X) + log(X * X + 1.0) / cosh(X) + sqrt(X * X);
+	int const count = 1000;
+	std::vector<double> args(count), res(count);
+	for (int i = 0; i < count; ++i) args[i] = -5.0 + i * 0.01;
+
+	f.evaluate(args.data(), res.data(), count);
+	for (int i = 0; i < count; ++i) EXPECT_NEAR(res[i], f(args[i]), 1e-13 * (1.0 + std::fabs(res[i])));
+
+	// in place gives the same values
+	f.evaluate(args.data(), args.data(), count);
+	EXPECT_EQ(args, res);
+}
+
+TEST(FunctionTest, EvaluateFloatTest) {
+	Xf const X;
+	auto const f = cos(X * 3.0f) + sinh(X) * log10(X * X + 2.0f);
+	int const count = 777;
+	std::vector<float> args(count), res(count);
+	for (int i = 0; i < count; ++i) args[i] = -2.0f + i * 0.005f;
+	f.evaluate(args.data(), res.data(), count);
+	for (int i = 0; i < count; ++i) EXPECT_NEAR(res[i], f(args[i]), 1e-5f * (1.0f + std::fabs(res[i])));
+}
+
+TEST(FunctionTest, TagTest) {
+	Xd const X;
+	auto const f = sin(X) * exp(X) + log10(X);
+	// nodes hold their operands only
+	static_assert(sizeof(sin(X)) == sizeof(Xd), "Function should not store more than its inner expression.");
+	static_assert(sizeof(f) == 3 * sizeof(Xd), "Composition should not store more than its leaves.");
+	EXPECT_EQ(f.toString(), "((sin(X))*(exp(X)))+(log10(X))");
+	EXPECT_DOUBLE_EQ(f(0.5), std::sin(0.5) * std::exp(0.5) + std::log10(0.5));
+}
+
+TEST(FunctionTest, DerivativeTest) {
+	Xd const X;
+	auto const f = sin(X) * exp(X) + log(X * X + 1.0) / cosh(X) + sqrt(X);
+	auto const df = f.derivative();
+	auto const exact = [](double x) {
+		double const inner = x * x + 1.0;
+		return (std::cos(x) + std::sin(x)) * std::exp(x)
+			+ (2.0 * x / inner * std::cosh(x) - std::log(inner) * std::sinh(x)) / (std::cosh(x) * std::cosh(x))
+			+ 0.5 / std::sqrt(x);
+	};
+	int const count = 500;
+	std::vector<double> args(count), res(count);
+	for (int i = 0; i < count; ++i) args[i] = 0.05 + i * 0.01;
+	df.evaluate(args.data(), res.data(), count);
+	for (int i = 0; i < count; ++i) {
+		EXPECT_NEAR(df(args[i]), exact(args[i]), 1e-12 * (1.0 + std::fabs(res[i])));
+		EXPECT_NEAR(res[i], df(args[i]), 1e-13 * (1.0 + std::fabs(res[i])));
+	}
+
+	// second derivative of the chain rule
+	auto const d2 = cos(X * X).derivative().derivative();
+	EXPECT_NEAR(d2(0.7), -2.0 * std::sin(0.49) - 4.0 * 0.49 * std::cos(0.49), 1e-13);
+	EXPECT_NEAR(log10(X * 3.0).derivative()(2.0), 1.0 / (2.0 * std::log(10.0)), 1e-15);
+}
+
+TEST(FunctionTest, DerivativeSimplificationTest) {
+	Xd const X;
+	// ones and zeros fold away, polynomials combine
+	EXPECT_EQ(sin(X).derivative().toString(), "cos(X)");
+	EXPECT_EQ(exp(X * X).derivative().toString(), "(exp(X^2))*(2*X)");
+	EXPECT_EQ((X * X * 3.0 + X).derivative().toString(), "6*X+1");
+	EXPECT_EQ((sin(X) + X).derivative().toString(), "(cos(X))+(1)");
+	EXPECT_EQ((sin(X) / (X + 1.0)).derivative().toString(), "(((cos(X))*(X+1))-(sin(X)))/(X^2+2*X+1)");
+	EXPECT_EQ((sin(X) / Oned()).derivative().toString(), "cos(X)");
+	EXPECT_EQ(log(X).derivative().toString(), "(1)/(X)");
+	EXPECT_EQ(Zerod().toString(), "0");
+	// the derivative of a constant is zero by type
+	static_assert(std::is_same<decltype(Oned().derivative()), Zerod>::value, "Constant should differentiate to Zero_.");
+	static_assert(std::is_same<decltype(X.derivative()), Oned>::value, "X should differentiate to One_.");
+}
+
+TEST(FunctionTest, OperatorsTest) {
+	Xd const X;
+	auto const f = 2.0 * sin(X) - cos(X) / 3.0 + -exp(X) + X * tanh(X) - pow<3>(atan(X)) + pow<-2>(cosh(X)) + abs(X - 1.0) * tan(X);
+	auto const exact = [](double x) {
+		return 2.0 * std::sin(x) - std::cos(x) / 3.0 - std::exp(x) + x * std::tanh(x) - std::pow(std::atan(x), 3)
+			+ 1.0 / (std::cosh(x) * std::cosh(x)) + std::abs(x - 1.0) * std::tan(x);
+	};
+	int const count = 600;
+	std::vector<double> args(count), res(count);
+	for (int i = 0; i < count; ++i) args[i] = -1.5 + i * 0.005;
+	f.evaluate(args.data(), res.data(), count);
+	for (int i = 0; i < count; ++i) {
+		EXPECT_NEAR(f(args[i]), exact(args[i]), 1e-12 * (1.0 + std::fabs(res[i])));
+		EXPECT_NEAR(res[i], f(args[i]), 1e-12 * (1.0 + std::fabs(res[i])));
+	}
+
+	EXPECT_EQ((1.0 - sin(X)).toString(), "(1)-(sin(X))");
+	EXPECT_EQ((-cos(X)).toString(), "-(cos(X))");
+	EXPECT_EQ(pow<3>(sin(X)).toString(), "(sin(X))^3");
+	EXPECT_EQ((X - X * 2.0).toString(), "-X");
+	// integer powers of polynomials are multiplied out
+	static_assert(std::is_same<decltype(pow<3>(X + 1.0)), PolynomicFunction<3, double>>::value, "pow of a polynomial should be a polynomial.");
+	EXPECT_EQ(pow<3>(X + 1.0).toString(), "X^3+3*X^2+3*X+1");
+	static_assert(std::is_same<decltype(pow<0>(sin(X))), Oned>::value, "pow<0> should be One_.");
+}
+
+TEST(FunctionTest, OperatorsDerivativeTest) {
+	Xd const X;
+	auto const f = pow<3>(sin(X)) - tan(X) * atan(X) + tanh(X * X) / (2.0 - cos(X)) + abs(X - 1.0);
+	auto const df = f.derivative();
+	auto const exact = [](double x) {
+		double const s = std::sin(x), c = std::cos(x), t = std::tan(x), th = std::tanh(x * x);
+		return 3.0 * s * s * c - (1.0 + t * t) * std::atan(x) - t / (1.0 + x * x)
+			+ ((1.0 - th * th) * 2.0 * x * (2.0 - c) - th * s) / ((2.0 - c) * (2.0 - c)) + (x > 1.0 ? 1.0 : -1.0);
+	};
+	double const args[] = { -1.2, -0.4, 0.3, 0.9, 1.4 };
+	for (double const arg : args) EXPECT_NEAR(df(arg), exact(arg), 1e-12);
+	EXPECT_EQ((-sin(X)).derivative().toString(), "-(cos(X))");
+	EXPECT_EQ(pow<2>(sin(X)).derivative().toString(), "((2)*(sin(X)))*(cos(X))");
+}
@@ -0,0 +1,109 @@
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <gtest/gtest.h>
+#include "../src/Half.h"
+#include "../src/Matrix.h"
+
+using namespace bm;
+
+TEST(HalfTest, ConversionTest) {
+	// every finite half and infinity survive a round trip through float, NaNs stay NaN
+	for (int bits = 0; bits < 0x10000; ++bits) {
+		half const value = half::fromBits(static_cast<std::uint16_t>(bits));
+		float const widened = value;
+		if (std::isnan(widened)) {
+			EXPECT_TRUE(std::isnan(float(half(widened))));
+		}
+		else {
+			EXPECT_EQ(half(widened).bits, value.bits);
+		}
+	}
+
+	EXPECT_EQ(float(half(1.0f)), 1.0f);
+	EXPECT_EQ(float(half(-2.5f)), -2.5f);
+	EXPECT_EQ(float(half(65504.0f)), 65504.0f);
+	EXPECT_EQ(float(half::fromBits(0x0001)), std::ldexp(1.0f, -24));
+	// round to nearest even
+	EXPECT_EQ(float(half(1.0f + std::ldexp(1.0f, -11))), 1.0f);
+	EXPECT_EQ(float(half(1.0f + 3 * std::ldexp(1.0f, -11))), 1.0f + std::ldexp(1.0f, -9));
+	EXPECT_EQ(half(std::ldexp(1.0f, -25)).bits, 0);
+	EXPECT_EQ(half(3 * std::ldexp(1.0f, -26)).bits, 1);
+	EXPECT_EQ(float(half(65519.0f)), 65504.0f);
+	EXPECT_TRUE(std::isinf(float(half(65520.0f))));
+	EXPECT_TRUE(std::isinf(float(half(1e10f))));
+	EXPECT_EQ(half(-0.0f).bits, 0x8000);
+
+	EXPECT_EQ(float(std::numeric_limits<half>::max()), 65504.0f);
+	EXPECT_EQ(float(std::numeric_limits<half>::lowest()), -65504.0f);
+	EXPECT_EQ(float(std::numeric_limits<half>::epsilon()), std::ldexp(1.0f, -10));
+}
+
+TEST(HalfTest, BFloat16ConversionTest) {
+	for (int bits = 0; bits < 0x10000; ++bits) {
+		bfloat16 const value = bfloat16::fromBits(static_cast<std::uint16_t>(bits));
+		float const widened = value;
+		if (std::isnan(widened)) {
+			EXPECT_TRUE(std::isnan(float(bfloat16(widened))));
+		}
+		else {
+			EXPECT_EQ(bfloat16(widened).bits, value.bits);
+		}
+	}
+
+	EXPECT_EQ(float(bfloat16(1.0f + std::ldexp(1.0f, -8))), 1.0f);
+	EXPECT_EQ(float(bfloat16(1.0f + 3 * std::ldexp(1.0f, -8))), 1.0f + std::ldexp(1.0f, -6));
+	EXPECT_NEAR(float(bfloat16(3e38f)) / 3e38f, 1.0f, std::ldexp(1.0f, -8));
+	EXPECT_TRUE(std::isnan(float(bfloat16(std::numeric_limits<float>::quiet_NaN()))));
+	EXPECT_EQ(float(std::numeric_limits<bfloat16>::max()), 3.3895314e38f);
+}
+
+TEST(HalfTest, BatchConversionTest) {
+	int const count = 1000;
+	std::vector<float> values(count), back(count);
+	std::vector<half> halves(count);
+	std::vector<bfloat16> bfloats(count);
+	for (int i = 0; i < count; ++i) values[i] = std::sin(i * 0.37f) * std::ldexp(1.0f, i % 40 - 30);
+	simd::convert(values.data(), halves.data(), count);
+	simd::convert(values.data(), bfloats.data(), count);
+	for (int i = 0; i < count; ++i) {
+		EXPECT_EQ(halves[i].bits, half(values[i]).bits);
+		EXPECT_EQ(bfloats[i].bits, bfloat16(values[i]).bits);
+	}
+	simd::convert(halves.data(), back.data(), count);
+	for (int i = 0; i < count; ++i) EXPECT_EQ(back[i], float(halves[i]));
+
+	Vector<3, float> const vecs[] = { Vector3f(1.0f, 2.0f, 3.0f), Vector3f(0.1f, -0.2f, 1e5f) };
+	Vector<3, half> halfVecs[2];
+	changeT(vecs, halfVecs, 2);
+	EXPECT_TRUE(equals(changeT<float>(halfVecs[0]), vecs[0]));
+	EXPECT_TRUE(std::isinf(float(halfVecs[1].z)));
+}
+
+TEST(HalfTest, VectorMatrixTest) {
+	using Vector3h = Vector<3, half>;
+	using Matrix3h = Matrix<3, 3, half>;
+
+	Vector3h const a(1.0f, 2.0f, 3.0f), b(0.5f, -1.0f, 2.0f);
+	EXPECT_TRUE(equals(a + b, Vector3h(1.5f, 1.0f, 5.0f)));
+	EXPECT_TRUE(equals(a * half(2.0f), Vector3h(2.0f, 4.0f, 6.0f)));
+	EXPECT_EQ(a.dot(b), 4.5f);
+	EXPECT_FLOAT_EQ(a.norm(), std::sqrt(14.0f));
+
+	// sums are widened to float: 4096 ones would stop growing at 2048 in half
+	std::vector<half> ones(4096, half(1.0f));
+	EXPECT_EQ(simd::dot(ones.data(), ones.data(), 4096), 4096.0f);
+
+	Matrix3h const identity;
+	EXPECT_EQ(float(identity.at(1, 1)), 1.0f);
+	EXPECT_EQ(float(identity.at(0, 1)), 0.0f);
+	Matrix3h const mat({
+		2.0f, 0.0f, 1.0f,
+		0.0f, 4.0f, 0.0f,
+		1.0f, 0.0f, 2.0f
+	});
+	EXPECT_TRUE(equals(mat * identity, mat));
+	EXPECT_TRUE(equals(mat * mat.inv(), identity, half(1e-3f)));
+	EXPECT_NEAR(mat.det(), 12.0f, 1e-2f);
+	EXPECT_TRUE(equals(mat * a, Vector3h(5.0f, 8.0f, 7.0f)));
+}
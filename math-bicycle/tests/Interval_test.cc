@@ -0,0 +1,135 @@
+#include <cmath>
+#include <vector>
+#include <gtest/gtest.h>
+#include "../src/Function.h"
+#include "../src/Interval.h"
+#include "../src/PolynomicFunction.h"
+#include "../src/Random.h"
+#include "../src/RationalFunction.h"
+
+using namespace bm;
+
+// every value of f over x, sampled densely, lies in the bound
+template <typename Func, typename Bound>
+void expectEncloses(Func const& f, Bound const& bound, double lo, double hi) {
+	EXPECT_LE(bound.lo, bound.hi);
+	for (int i = 0; i <= 1000; ++i) {
+		double const x = i == 1000 ? hi : lo + (hi - lo) * i / 1000.0;
+		double const value = f(x);
+		EXPECT_TRUE(bound.contains(value)) << "f(" << x << ") = " << value << " outside [" << bound.lo << ", " << bound.hi << "]";
+	}
+}
+
+TEST(IntervalTest, ArithmeticTest) {
+	Intervald const a(1.0, 2.0), b(-3.0, 0.5);
+	Intervald const sum = a + b, difference = a - b, product = a * b, quotient = b / a;
+	EXPECT_TRUE(sum.contains(Intervald(-2.0, 2.5)));
+	EXPECT_TRUE(difference.contains(Intervald(0.5, 5.0)));
+	EXPECT_TRUE(product.contains(Intervald(-6.0, 1.0)));
+	EXPECT_TRUE(quotient.contains(Intervald(-3.0, 0.5)));
+	// rounded outward by one ulp only
+	EXPECT_EQ(sum.lo, std::nextafter(-2.0, -10.0));
+	EXPECT_EQ(sum.hi, std::nextafter(2.5, 10.0));
+
+	// 0.1 + 0.2 is not 0.3 in doubles, the interval holds the exact sum of the doubles
+	Intervald const tenth(0.1), fifth(0.2);
+	Intervald const exact = tenth + fifth;
+	EXPECT_TRUE(exact.contains(0.1 + 0.2));
+	EXPECT_LT(exact.width(), 1e-15);
+
+	EXPECT_EQ(a / b, Intervald::entire());
+	EXPECT_EQ(-b, Intervald(-0.5, 3.0));
+	EXPECT_EQ((2.0 * a).hi, std::nextafter(4.0, 10.0));
+	EXPECT_EQ(Intervald(0.0, 1.0) * Intervald::entire(), Intervald::entire());
+}
+
+TEST(IntervalTest, MathFunctionsTest) {
+	double const ranges[][2] = { { -0.3, 0.2 }, { 0.5, 2.5 }, { 1.4, 1.8 }, { -4.0, -1.0 }, { 3.0, 9.0 }, { -0.01, 0.01 } };
+	for (auto const& range : ranges) {
+		Intervald const x(range[0], range[1]);
+		expectEncloses([](double v) { return std::sin(v); }, sin(x), range[0], range[1]);
+		expectEncloses([](double v) { return std::cos(v); }, cos(x), range[0], range[1]);
+		expectEncloses([](double v) { return std::exp(v); }, exp(x), range[0], range[1]);
+		expectEncloses([](double v) { return std::sinh(v); }, sinh(x), range[0], range[1]);
+		expectEncloses([](double v) { return std::cosh(v); }, cosh(x), range[0], range[1]);
+		expectEncloses([](double v) { return std::tanh(v); }, tanh(x), range[0], range[1]);
+		expectEncloses([](double v) { return std::atan(v); }, atan(x), range[0], range[1]);
+		expectEncloses([](double v) { return std::abs(v); }, abs(x), range[0], range[1]);
+		if (range[0] > 0) {
+			expectEncloses([](double v) { return std::log(v); }, log(x), range[0], range[1]);
+			expectEncloses([](double v) { return std::log10(v); }, log10(x), range[0], range[1]);
+			expectEncloses([](double v) { return std::sqrt(v); }, sqrt(x), range[0], range[1]);
+		}
+	}
+	// extrema inside are found, not only the ends
+	EXPECT_EQ(sin(Intervald(1.0, 2.0)).hi, 1.0);
+	EXPECT_EQ(cos(Intervald(3.0, 3.5)).lo, -1.0);
+	EXPECT_EQ(cosh(Intervald(-1.0, 2.0)).lo, 1.0);
+	EXPECT_EQ(tan(Intervald(1.0, 2.0)), Intervald::entire());
+	expectEncloses([](double v) { return std::tan(v); }, tan(Intervald(-1.0, 1.0)), -1.0, 1.0);
+	EXPECT_EQ(sqrt(Intervald(-1.0, 4.0)).lo, 0.0);
+}
+
+// point intervals against the long double library, which is more precise than double
+template <typename Func, typename LongFunc>
+void expectContainsReference(Func const& func, LongFunc const& reference, double const* args, int count) {
+	int misses = 0;
+	for (int i = 0; i < count; ++i) {
+		Intervald const res = func(Intervald(args[i]));
+		long double const exact = reference(static_cast<long double>(args[i]));
+		misses += res.lo <= exact && exact <= res.hi ? 0 : 1;
+	}
+	EXPECT_EQ(misses, 0);
+}
+
+TEST(IntervalTest, LibraryErrorTest) {
+	int const count = 200000;
+	std::vector<double> args(count), positive(count);
+	random::Generator generator(5);
+	generator.uniform(args.data(), count, -5.0, 5.0);
+	generator.uniform(positive.data(), count, 1e-3, 1e3);
+	double const* x = args.data();
+	expectContainsReference([](Intervald const& v) { return exp(v); }, [](long double v) { return std::exp(v); }, x, count);
+	expectContainsReference([](Intervald const& v) { return sinh(v); }, [](long double v) { return std::sinh(v); }, x, count);
+	expectContainsReference([](Intervald const& v) { return cosh(v); }, [](long double v) { return std::cosh(v); }, x, count);
+	expectContainsReference([](Intervald const& v) { return tanh(v); }, [](long double v) { return std::tanh(v); }, x, count);
+	expectContainsReference([](Intervald const& v) { return atan(v); }, [](long double v) { return std::atan(v); }, x, count);
+	expectContainsReference([](Intervald const& v) { return sin(v); }, [](long double v) { return std::sin(v); }, x, count);
+	expectContainsReference([](Intervald const& v) { return cos(v); }, [](long double v) { return std::cos(v); }, x, count);
+	expectContainsReference([](Intervald const& v) { return tan(v); }, [](long double v) { return std::tan(v); }, x, count);
+	double const* p = positive.data();
+	expectContainsReference([](Intervald const& v) { return log(v); }, [](long double v) { return std::log(v); }, p, count);
+	expectContainsReference([](Intervald const& v) { return log10(v); }, [](long double v) { return std::log10(v); }, p, count);
+	expectContainsReference([](Intervald const& v) { return sqrt(v); }, [](long double v) { return std::sqrt(v); }, p, count);
+}
+
+TEST(IntervalTest, FunctionTest) {
+	Xd const X;
+	auto const f = sin(X * 3.0) * exp(-X) + X * X / (cosh(X) + 1.0) - pow<3>(X - 0.5);
+	double const coefficients[] = { 2.0, -3.0, 0.5, 7.0 };
+	PolynomicFunction<3, double> const poly(coefficients);
+	RationalFunction<double, 2, 1> const rational(X * X + 1.0, X - 3.0);
+
+	// expressions on doubles take interval arguments
+	double const ranges[][2] = { { -1.0, 1.0 }, { 0.25, 0.5 }, { 1.0, 2.5 }, { -2.0, -1.9 } };
+	for (auto const& range : ranges) {
+		Intervald const x(range[0], range[1]);
+		expectEncloses(f, f(x), range[0], range[1]);
+		expectEncloses(poly, poly(x), range[0], range[1]);
+		expectEncloses(rational, rational(x), range[0], range[1]);
+	}
+	// the bound gets tight on narrow intervals
+	Intervald const narrow = f(Intervald(0.3, 0.3 + 1e-6));
+	EXPECT_LT(narrow.width(), 1e-4);
+
+	// and expressions built on intervals evaluate them in batches
+	X_<Intervald> const intervalX;
+	auto const g = sin(intervalX) * intervalX + Intervald(1.0);
+	std::vector<Intervald> args, res(50);
+	for (int i = 0; i < 50; ++i) args.emplace_back(i * 0.1, i * 0.1 + 0.05);
+	g.evaluate(args.data(), res.data(), 50);
+	for (int i = 0; i < 50; ++i) {
+		EXPECT_EQ(res[i], g(args[i]));
+		expectEncloses([](double v) { return std::sin(v) * v + 1.0; }, res[i], args[i].lo, args[i].hi);
+	}
+}
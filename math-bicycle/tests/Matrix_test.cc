@@ -182,3 +182,62 @@ TEST(MatrixTest, DeterminantCalculationTest) {
 	EXPECT_TRUE(equals(mat3f.det(),			 mat3f_det(init_array1), precission));
 	EXPECT_TRUE(equals(zero_det_mat3f.det(), mat3f_det(init_array2), precission));
 }
+
+TEST(MatrixTest, PaddedRowsTest) {
+	int const Rows = 3;
+	int const Cols = 5;
+	float init_array[Rows * Cols] = {
+		1.1f,  2.2f,  3.3f,  4.4f,  5.5f,
+		6.6f,  7.7f,  8.8f,  9.9f,  10.1f,
+		11.1f, 12.2f, 13.3f, 14.4f, 15.5f
+	};
+	using Mat3x5f = Matrix<Rows, Cols, float>;
+	using Layout = simd::Layout<float>;
+	Mat3x5f mat(init_array);
+
+	EXPECT_GE(Mat3x5f::Stride, Cols);
+	EXPECT_EQ(Mat3x5f::Stride % Layout::lanes, 0);
+	for (int i = 0; i < Rows; ++i) {
+		EXPECT_TRUE(simd::isAligned(&mat.at(i, 0), Layout::alignment));
+		for (int j = 0; j < Cols; ++j) {
+			EXPECT_EQ(mat.at(i, j), init_array[i * Cols + j]);
+		}
+	}
+
+	mat[0].addScaled(mat[2], -2.0f);
+	mat[1].swap(mat[2]);
+	for (int j = 0; j < Cols; ++j) {
+		EXPECT_NEAR(mat.at(0, j), init_array[j] - 2.0f * init_array[2 * Cols + j], precission);
+		EXPECT_EQ(mat.at(1, j), init_array[2 * Cols + j]);
+		EXPECT_EQ(mat.at(2, j), init_array[Cols + j]);
+	}
+}
+
+TEST(MatrixTest, RowOperationsTest) {
+	int const Dim = 3;
+	float init_array[Dim * Dim] = {
+		1.1f, 7.7f,   14.14f,
+		4.4f, 22.22f, 6.6f,
+		7.7f, 12.12f, 9.9f
+	};
+	int int_array[Dim * Dim] = {
+		10, 20, 30,
+		40, 50, 60,
+		70, 80, 90
+	};
+	float const scale = 3.3f;
+
+	Matrix<Dim, Dim, float> mat3f(init_array);
+	Matrix<Dim, Dim, int> mat3i(int_array);
+
+	mat3f[0].scale(scale, false);
+	mat3f[1].addScaled(mat3f.at(2), scale, false);
+	mat3f[2].fill(1.0f);
+	mat3i[0].scale(7, false);
+	for (int j = 0; j < Dim; ++j) {
+		EXPECT_NEAR(mat3f.at(0, j), init_array[j] / scale, precission);
+		EXPECT_NEAR(mat3f.at(1, j), init_array[Dim + j] + init_array[2 * Dim + j] / scale, precission);
+		EXPECT_EQ(mat3f.at(2, j), 1.0f);
+		EXPECT_EQ(mat3i.at(0, j), int_array[j] / 7);
+	}
+}
@@ -0,0 +1,150 @@
+#include <cmath>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include "../src/Function.h"
+#include "../src/Interval.h"
+#include "../src/Polynomial.h"
+#include "../src/PolynomicFunction.h"
+#include "../src/Random.h"
+#include "../src/Tape.h"
+
+using namespace bm;
+
+double const precision = 1e-9;
+
+TEST(PolynomialTest, ArithmeticTest) {
+	Polynomiald const p = { 2.0, -3.0, 0.5, 7.0 };
+	Polynomiald const q = { 1.0, -1.0 };
+	EXPECT_EQ(p.degree(), 3);
+	EXPECT_EQ(p.coefficient(0), 7.0);
+	EXPECT_EQ(p.coefficient(3), 2.0);
+	EXPECT_EQ(p.coefficient(5), 0.0);
+
+	double const args[] = { -2.0, 0.0, 0.5, 3.0 };
+	for (double const x : args) {
+		EXPECT_NEAR((p * q)(x), p(x) * q(x), precision);
+		EXPECT_NEAR((p + q)(x), p(x) + q(x), precision);
+		EXPECT_NEAR((q - p)(x), q(x) - p(x), precision);
+		EXPECT_NEAR((p * 3.0)(x), 3.0 * p(x), precision);
+		EXPECT_NEAR((2.0 * p)(x), 2.0 * p(x), precision);
+		EXPECT_NEAR((p + 1.5)(x), p(x) + 1.5, precision);
+		EXPECT_NEAR((p - 1.5)(x), p(x) - 1.5, precision);
+		EXPECT_NEAR((-p)(x), -p(x), precision);
+		EXPECT_NEAR(p.derivative()(x), 6.0 * x * x - 6.0 * x + 0.5, precision);
+	}
+	EXPECT_EQ((p * q).degree(), 4);
+
+	// leading terms that cancel lower the degree
+	EXPECT_EQ((p - p).degree(), 0);
+	EXPECT_EQ(p - p, Polynomiald());
+	EXPECT_EQ((p - Polynomiald({ 2.0, 0.0, 0.0, 0.0 })).degree(), 2);
+	EXPECT_EQ(Polynomiald({ 0.0, 0.0, 1.0 }).degree(), 0);
+	EXPECT_EQ((p * 0.0).degree(), 0);
+	EXPECT_EQ(Polynomiald({ 5.0 }).derivative(), Polynomiald());
+
+	// degrees past the inline storage spill to the heap
+	Polynomiald power = { 1.0 };
+	for (int i = 0; i < 40; ++i) power = power * q;
+	EXPECT_EQ(power.degree(), 40);
+	// the binomial coefficients are exact in doubles, and so is Horner at 2
+	EXPECT_EQ(power(2.0), 1.0);
+	EXPECT_NEAR(power.coefficient(1), -40.0, precision);
+}
+
+TEST(PolynomialTest, ConversionTest) {
+	double const coefficients[] = { 2.0, -3.0, 0.5, 7.0 };
+	PolynomicFunction<3, double> const fixed(coefficients);
+	Polynomiald const dynamic = fixed;
+	EXPECT_EQ(dynamic.toString(), fixed.toString());
+	EXPECT_EQ(dynamic.toString(), "2*X^3-3*X^2+0.5*X+7");
+
+	auto const back = dynamic.toPolynomic<3>();
+	auto const wider = dynamic.toPolynomic<5>();
+	for (double x = -2.0; x <= 2.0; x += 0.5) {
+		EXPECT_EQ(back(x), fixed(x));
+		EXPECT_EQ(wider(x), fixed(x));
+	}
+	EXPECT_EQ(wider.toString(), fixed.toString());
+	EXPECT_EQ(Polynomiald(Xd()).toString(), "X");
+	EXPECT_EQ(Polynomiald().toString(), "0");
+
+	// products of fixed polynomials of any degree stay one type
+	Polynomiald product = Xd() + 1.0;
+	for (int i = 0; i < 4; ++i) product = product * Polynomiald(Xd() * Xd() - 2.0);
+	EXPECT_EQ(product.degree(), 9);
+}
+
+TEST(PolynomialTest, EvaluateTest) {
+	Polynomiald const p = { 2.0, -3.0, 0.5, 7.0 };
+	std::vector<double> args(100), res(100);
+	for (int i = 0; i < 100; ++i) args[i] = -3.0 + 0.06 * i;
+	p.evaluate(args.data(), res.data(), 100);
+	for (int i = 0; i < 100; ++i) EXPECT_EQ(res[i], p(args[i]));
+
+	Intervald const range = p(Intervald(0.0, 1.0));
+	for (double x = 0.0; x <= 1.0; x += 0.01) EXPECT_TRUE(range.contains(p(x)));
+
+	// as the inner function of an expression, and compiled to a tape
+	Xd const X;
+	auto const f = sin(p) + X;
+	EXPECT_NEAR(f(0.7), std::sin(p(0.7)) + 0.7, precision);
+	EXPECT_NEAR(f.derivative()(0.7), std::cos(p(0.7)) * p.derivative()(0.7) + 1.0, precision);
+	Tape<double> const tape = compile(f);
+	EXPECT_NEAR(tape(0.7), f(0.7), precision);
+}
+
+TEST(PolynomialTest, FitTest) {
+	// exact points of a cubic are fitted exactly by a cubic, and by every higher degree
+	Polynomiald const cubic = { 0.5, -1.0, 2.0, 3.0 };
+	std::vector<Vector<2, double>> points;
+	for (int i = 0; i < 12; ++i) {
+		double const x = -1.0 + i * 0.2;
+		points.emplace_back(x, cubic(x));
+	}
+	for (int degree = 3; degree <= 5; ++degree) {
+		Polynomiald const fit = fitPolynomial(points.data(), 12, degree);
+		EXPECT_LE(fit.degree(), degree);
+		for (auto const& point : points) EXPECT_NEAR(fit(point.x), point.y, 1e-6);
+	}
+
+	// a line through noisy points is the least squares one
+	Vector<2, double> const line[] = { Vector<2, double>(0.0, 1.0), Vector<2, double>(1.0, 2.0), Vector<2, double>(2.0, 2.0), Vector<2, double>(3.0, 4.0) };
+	Polynomiald const fit = fitPolynomial(line, 4, 1);
+	EXPECT_NEAR(fit.coefficient(1), 0.9, precision);
+	EXPECT_NEAR(fit.coefficient(0), 0.9, precision);
+}
+
+TEST(PolynomialTest, MultiplicationTest) {
+	namespace internal = _PolynomicFunctionInternal;
+	random::Generator generator(7);
+	// Karatsuba, one and several pieces of it, and FFT, against the term by term product
+	int const sizes[][2] = { { 100, 100 }, { 1000, 90 }, { 5000, 5000 }, { 4100, 6000 } };
+	for (auto const& size : sizes) {
+		int const na = size[0], nb = size[1];
+		std::vector<double> a(na), b(nb), expected(na + nb - 1), res(na + nb - 1);
+		generator.uniform(a.data(), na, -1.0, 1.0);
+		generator.uniform(b.data(), nb, -1e-3, 1e-3);
+		internal::schoolbook(a.data(), na, b.data(), nb, expected.data());
+		internal::multiply(a.data(), na, b.data(), nb, res.data());
+		for (int k = 0; k < na + nb - 1; ++k) EXPECT_NEAR(res[k], expected[k], 1e-12);
+	}
+
+	// integers stay exact
+	std::vector<long long> a(300), b(200), expected(499), res(499);
+	for (int i = 0; i < 300; ++i) a[i] = i % 17 - 8;
+	for (int i = 0; i < 200; ++i) b[i] = i % 5 - 2;
+	internal::schoolbook(a.data(), 300, b.data(), 200, expected.data());
+	internal::multiply(a.data(), 300, b.data(), 200, res.data());
+	EXPECT_EQ(res, expected);
+
+	// through Polynomial, down to the zero polynomial
+	std::vector<double> coefficients(5000);
+	generator.uniform(coefficients.data(), 5000, -1.0, 1.0);
+	Polynomiald const p(coefficients.data(), 5000);
+	Polynomiald const square = p * p;
+	EXPECT_EQ(square.degree(), 2 * p.degree());
+	EXPECT_NEAR(square(0.5), p(0.5) * p(0.5), 1e-9);
+	EXPECT_EQ(p * Polynomiald(), Polynomiald());
+	EXPECT_EQ((p * (p - p)).degree(), 0);
+}
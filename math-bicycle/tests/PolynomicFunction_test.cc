@@ -1,4 +1,5 @@
 #include <cmath>
+#include <vector>
 #include <gtest/gtest.h>
 #include "../src/PolynomicFunction.h"
 
@@ -69,4 +70,40 @@ TEST(PolynomicFunctionTest, MultiplicationTest) {
 	float zeros[N] = { 0.f, 1.f, -1.f, 3.f };
 	auto f = (X - zeros[0]) * (X - zeros[1]) * (X - zeros[2]) * (X - zeros[3]);
 	for (int i = 0; i < N; ++i) { EXPECT_NEAR(f(zeros[i]), 0.f, precission); }
-}
\ No newline at end of file
+}
+
+TEST(PolynomicFunctionTest, EvaluateTest) {
+	int const count = 1000;
+	float const coefficients[] = { 3.f, -25.f, 0.5f, 60.f, 1.f };
+	bm::PolynomicFunction<4, float> const f(coefficients);
+	std::vector<float> args(count), res(count);
+	for (int i = 0; i < count; ++i) { args[i] = -4.f + i * 0.008f; }
+	f.evaluate(args.data(), res.data(), count);
+	for (int i = 0; i < count; ++i) { EXPECT_EQ(res[i], f(args[i])); }
+	// in place
+	f.evaluate(args.data(), args.data(), count);
+	EXPECT_EQ(args, res);
+}
+
+TEST(PolynomicFunctionTest, HighDegreeTest) {
+	// Chebyshev T_12 stays in [-1, 1] on [-1, 1] while its coefficients reach 2048
+	double const coefficients[] = { 2048., 0., -6144., 0., 6912., 0., -3584., 0., 840., 0., -72., 0., 1. };
+	bm::PolynomicFunction<12, double> const t12(coefficients);
+	int const count = 1 << 18;
+	std::vector<double> args(count), res(count);
+	for (int i = 0; i < count; ++i) { args[i] = -1.0 + 2.0 * i / (count - 1); }
+	t12.evaluate(args.data(), res.data(), count);
+	for (int i = 0; i < count; i += 97) {
+		double const expected = std::cos(12.0 * std::acos(args[i]));
+		// operator() goes through Estrin's scheme, evaluate through Horner's
+		EXPECT_NEAR(t12(args[i]), expected, 1e-11);
+		EXPECT_NEAR(res[i], expected, 1e-11);
+	}
+
+	// the threads split the arguments, not the work on one, so the results do not depend on them
+	bm::parallel::setThreadCount(1);
+	std::vector<double> single(count);
+	t12.evaluate(args.data(), single.data(), count);
+	bm::parallel::setThreadCount(0);
+	EXPECT_EQ(single, res);
+}
@@ -0,0 +1,90 @@
+#include <vector>
+#include <gtest/gtest.h>
+#include "../src/RigidTransform.h"
+
+using namespace bm;
+
+namespace {
+	double const precission = 1e-9;
+	double const half_pi = std::acos(0.0);
+}
+
+TEST(QuaternionTest, RotationTest) {
+	Quaterniond const quarter_turn_z = Quaterniond::fromAxisAngle(Vector3d(0.0, 0.0, 2.0), half_pi);
+	EXPECT_NEAR(quarter_turn_z.norm(), 1.0, precission);
+	EXPECT_TRUE(equals(quarter_turn_z.rotate(Vector3d(1.0, 0.0, 0.0)), Vector3d(0.0, 1.0, 0.0), precission));
+	EXPECT_TRUE(equals((quarter_turn_z * quarter_turn_z).rotate(Vector3d(1.0, 2.0, 3.0)), Vector3d(-1.0, -2.0, 3.0), precission));
+	EXPECT_TRUE(equals(quarter_turn_z * quarter_turn_z.inv(), Quaterniond(), precission));
+
+	Quaterniond const q = Quaterniond(0.3, -0.5, 0.7, 0.2).normalized();
+	Vector3d const vec(1.5, -2.0, 0.25);
+	EXPECT_TRUE(equals(q.toMatrix() * vec, q.rotate(vec), precission));
+	// every branch of the matrix conversion, q and -q being the same rotation
+	for (Quaterniond const& rotation : { q, Quaterniond(0.1, 0.9, 0.2, 0.1).normalized(), Quaterniond(0.1, 0.2, 0.9, 0.1).normalized(), Quaterniond(0.1, 0.1, 0.2, 0.9).normalized() }) {
+		Quaterniond const back = Quaterniond::fromMatrix(rotation.toMatrix());
+		EXPECT_TRUE(equals(back, rotation, precission) || equals(back, -rotation, precission));
+	}
+}
+
+TEST(QuaternionTest, SlerpTest) {
+	Quaterniond const from;
+	Quaterniond const to = Quaterniond::fromAxisAngle(Vector3d(1.0, 0.0, 0.0), half_pi);
+	EXPECT_TRUE(equals(slerp(from, to, 0.0), from, precission));
+	EXPECT_TRUE(equals(slerp(from, to, 1.0), to, precission));
+	EXPECT_TRUE(equals(slerp(from, to, 0.5), Quaterniond::fromAxisAngle(Vector3d(1.0, 0.0, 0.0), half_pi / 2), precission));
+	// the shorter arc is taken even if the target has the opposite sign
+	EXPECT_TRUE(equals(slerp(from, -to, 0.5), Quaterniond::fromAxisAngle(Vector3d(1.0, 0.0, 0.0), half_pi / 2), precission));
+	EXPECT_TRUE(equals(slerp(to, to, 0.3), to, precission));
+}
+
+TEST(RigidTransformTest, CompositionTest) {
+	RigidTransformd const first(Quaterniond::fromAxisAngle(Vector3d(0.0, 1.0, 0.0), 0.7), Vector3d(1.0, 2.0, 3.0));
+	RigidTransformd const second(Quaterniond::fromAxisAngle(Vector3d(1.0, 1.0, 0.0), -1.3), Vector3d(-4.0, 0.5, 2.0));
+	Point<3, double> const point(0.5, -1.5, 2.5);
+
+	EXPECT_TRUE(equals(RigidTransformd(first.toMatrix()), first, precission));
+	EXPECT_TRUE(equals((second * first).toMatrix(), second.toMatrix() * first.toMatrix(), precission));
+	EXPECT_TRUE(equals((second * first) * point, second * (first * point), precission));
+	EXPECT_TRUE(equals(first.inv() * (first * point), point, precission));
+	EXPECT_TRUE(equals(first.inv().toMatrix(), first.toMatrix().inv(), precission));
+
+	Point<4, double> const homogeneous = first.toMatrix() * Point<4, double>(point.x, point.y, point.z, 1.0);
+	EXPECT_TRUE(equals(homogeneous.xyz(), first * point, precission));
+
+	EXPECT_TRUE(equals(interpolate(first, second, 0.0), first, precission));
+	EXPECT_TRUE(equals(interpolate(first, second, 1.0), second, precission));
+}
+
+TEST(RigidTransformTest, BatchTransformTest) {
+	RigidTransformd const transform(Quaterniond(0.9, 0.1, -0.3, 0.2).normalized(), Vector3d(3.0, -1.0, 0.5));
+	int const count = 100;
+	std::vector<Point<3, double>> points, transformed(count);
+	for (int i = 0; i < count; ++i) {
+		points.push_back(Point<3, double>(i * 0.5, 1.0 - i, i * i * 0.01));
+	}
+	transform.transform(points.data(), transformed.data(), count);
+	for (int i = 0; i < count; ++i) {
+		EXPECT_TRUE(equals(transformed[i], transform * points[i], 1e-9 * count * count));
+	}
+}
+
+TEST(RigidTransformTest, BatchComposeTest) {
+	int const count = 100;
+	std::vector<RigidTransformd> parents, locals, composed(count);
+	std::vector<Point<3, double>> points, transformed(count);
+	for (int i = 0; i < count; ++i) {
+		parents.push_back(RigidTransformd(Quaterniond::fromAxisAngle(Vector3d(1.0, i * 0.1, -0.5), i * 0.07), Vector3d(i, -1.0, 0.5)));
+		locals.push_back(RigidTransformd(Quaterniond::fromAxisAngle(Vector3d(0.2, 1.0, i * 0.03), -i * 0.05), Vector3d(0.5, i * 0.2, 2.0)));
+		points.push_back(Point<3, double>(i * 0.5, 1.0 - i, 3.0));
+	}
+	compose(parents.data(), locals.data(), composed.data(), count);
+	transform(composed.data(), points.data(), transformed.data(), count);
+	for (int i = 0; i < count; ++i) {
+		EXPECT_TRUE(equals(composed[i], parents[i] * locals[i], precission));
+		EXPECT_TRUE(equals(transformed[i], composed[i] * points[i], precission * count));
+	}
+
+	// in place
+	compose(parents.data(), locals.data(), locals.data(), count);
+	for (int i = 0; i < count; ++i) EXPECT_EQ(locals[i], composed[i]);
+}
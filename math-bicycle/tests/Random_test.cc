@@ -0,0 +1,117 @@
+#include <cmath>
+#include <random>
+#include <vector>
+#include <gtest/gtest.h>
+#include "../src/Random.h"
+
+using namespace bm;
+
+TEST(RandomTest, PhiloxTest) {
+	// known answers of the reference implementation
+	random::_RandomInternal::Block const zero = random::_RandomInternal::philox(0, 0, 0);
+	EXPECT_EQ(zero.words[0], 0x6627e8d5u);
+	EXPECT_EQ(zero.words[1], 0xe169c58du);
+	EXPECT_EQ(zero.words[2], 0xbc57ac4cu);
+	EXPECT_EQ(zero.words[3], 0x9b00dbd8u);
+
+	std::uint64_t const ones = ~std::uint64_t(0);
+	random::_RandomInternal::Block const full = random::_RandomInternal::philox(ones, ones, ones);
+	EXPECT_EQ(full.words[0], 0x408f276du);
+	EXPECT_EQ(full.words[1], 0x41c83b0eu);
+	EXPECT_EQ(full.words[2], 0xa20bc7c6u);
+	EXPECT_EQ(full.words[3], 0x6d5451fdu);
+}
+
+TEST(RandomTest, ReproducibilityTest) {
+	random::Generator first(42), second(42), otherSeed(43), otherStream(42, 1);
+	std::vector<float> a(1000), b(1000), c(1000), d(1000);
+	first.uniform(a.data(), 1000);
+	second.uniform(b.data(), 1000);
+	otherSeed.uniform(c.data(), 1000);
+	otherStream.uniform(d.data(), 1000);
+	EXPECT_EQ(a, b);
+	EXPECT_NE(a, c);
+	EXPECT_NE(a, d);
+
+	// calls continue the sequence
+	first.uniform(a.data(), 1000);
+	EXPECT_NE(a, b);
+	EXPECT_EQ(first.position(), 500u);
+
+	// the same values whatever the number of threads
+	int const count = 1 << 20;
+	DynamicVector<double> single(count), threaded(count);
+	parallel::setThreadCount(1);
+	random::Generator(7).normal(single);
+	parallel::setThreadCount(4);
+	random::Generator(7).normal(threaded);
+	parallel::setThreadCount(0);
+	for (int i = 0; i < count; ++i) ASSERT_EQ(single[i], threaded[i]);
+
+	random::Generator urbg(1);
+	std::uniform_int_distribution<int> dice(1, 6);
+	for (int i = 0; i < 100; ++i) {
+		int const roll = dice(urbg);
+		EXPECT_TRUE(roll >= 1 && roll <= 6);
+	}
+}
+
+TEST(RandomTest, DistributionTest) {
+	int const count = 1 << 18;
+	random::Generator generator(3);
+
+	std::vector<float> uniform(count);
+	generator.uniform(uniform.data(), count, -2.0f, 6.0f);
+	double sum = 0;
+	for (float value : uniform) {
+		EXPECT_TRUE(value >= -2.0f && value < 6.0f);
+		sum += value;
+	}
+	EXPECT_NEAR(sum / count, 2.0, 0.05);
+
+	std::vector<double> normal(count);
+	generator.normal(normal.data(), count, 1.0, 3.0);
+	double mean = 0, variance = 0;
+	for (double value : normal) mean += value;
+	mean /= count;
+	for (double value : normal) variance += (value - mean) * (value - mean);
+	variance /= count;
+	EXPECT_NEAR(mean, 1.0, 0.03);
+	EXPECT_NEAR(std::sqrt(variance), 3.0, 0.03);
+
+	std::vector<int> ints(count);
+	generator.uniform(ints.data(), count, -3, 3);
+	std::vector<int> histogram(7, 0);
+	for (int value : ints) {
+		ASSERT_TRUE(value >= -3 && value <= 3);
+		++histogram[value + 3];
+	}
+	for (int hits : histogram) EXPECT_NEAR(hits, count / 7.0, count / 70.0);
+}
+
+TEST(RandomTest, FillTest) {
+	random::Generator generator(11);
+
+	Vector3f vec(0.0f);
+	generator.uniform(vec, 1.0f, 2.0f);
+	for (int i = 0; i < 3; ++i) EXPECT_TRUE(vec[i] >= 1.0f && vec[i] < 2.0f);
+
+	Matrix<4, 5, double> mat;
+	generator.normal(mat, 0.0, 1.0);
+	int nonZero = 0;
+	for (int i = 0; i < 4; ++i) for (int j = 0; j < 5; ++j) nonZero += mat.at(i, j) != 0.0;
+	EXPECT_EQ(nonZero, 20);
+
+	// a matrix takes the values a flat array would get
+	DynamicMatrix<float> dyn(17, 9);
+	std::vector<float> flat(17 * 9);
+	random::Generator(5).uniform(dyn);
+	random::Generator(5).uniform(flat.data(), 17 * 9);
+	for (int i = 0; i < 17; ++i) for (int j = 0; j < 9; ++j) EXPECT_EQ(dyn.at(i, j), flat[i * 9 + j]);
+
+	std::vector<Point3f> points(100);
+	random::Generator(5).uniform(points.data(), 100, -1.0f, 1.0f);
+	std::vector<float> coords(300);
+	random::Generator(5).uniform(coords.data(), 300, -1.0f, 1.0f);
+	for (int i = 0; i < 300; ++i) EXPECT_EQ(points[i / 3][i % 3], coords[i]);
+}
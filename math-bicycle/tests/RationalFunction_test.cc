@@ -1,3 +1,4 @@
+#include <vector>
 #include <gtest/gtest.h>
 #include "../src/PolynomicFunction.h"
 #include "../src/RationalFunction.h"
@@ -266,4 +267,15 @@ TEST(RationalFunctionTest, ScalarDivisionTest) {
 		auto const arg = args[i];
 		EXPECT_NEAR(resultedRationalFunction(arg), resultedRationalFunctionsImitator(arg), precission);
 	}
-}
\ No newline at end of file
+}
+
+TEST(RationalFunctionTest, EvaluateTest) {
+	int const count = 600;
+	float const numerator_coefficients[] = { -55.8f, -63.25f,  17.39f, 20.f };
+	float const denominator_coefficients[] = { 15.f, 73.1f, -63.25f, -333.2f, 20.f };
+	RationalFunction<float, 3, 4> const rationalFunction(numerator_coefficients, denominator_coefficients);
+	std::vector<float> args(count), res(count);
+	for (int i = 0; i < count; ++i) { args[i] = -3.f + i * 0.01f; }
+	rationalFunction.evaluate(args.data(), res.data(), count);
+	for (int i = 0; i < count; ++i) { EXPECT_EQ(res[i], rationalFunction(args[i])); }
+}
@@ -0,0 +1,148 @@
+#include <algorithm>
+#include <complex>
+#include <memory>
+#include <vector>
+#include <gtest/gtest.h>
+#include "../src/Parallel.h"
+#include "../src/Polynomial.h"
+#include "../src/PolynomicFunction.h"
+#include "../src/Random.h"
+#include "../src/RationalFunction.h"
+#include "../src/Roots.h"
+
+using namespace bm;
+
+// every expected root is within precision of one found
+void expectRoots(std::complex<double> const* found, int count, std::vector<std::complex<double>> const& expected, double precision) {
+	ASSERT_EQ(count, static_cast<int>(expected.size()));
+	for (auto const& root : expected) {
+		double closest = std::abs(found[0] - root);
+		for (int k = 1; k < count; ++k) closest = std::min(closest, std::abs(found[k] - root));
+		EXPECT_LE(closest, precision) << root;
+	}
+}
+
+TEST(RootsTest, AllRootsTest) {
+	Xd const X;
+	auto const p = (X - 1.0) * (X + 2.0) * (X * X + 1.0) * (X - 3.0);
+	std::complex<double> res[5];
+	bool converged = false;
+	EXPECT_EQ(roots(p, res, &converged), 5);
+	EXPECT_TRUE(converged);
+	expectRoots(res, 5, { 1.0, -2.0, { 0.0, 1.0 }, { 0.0, -1.0 }, 3.0 }, 1e-12);
+
+	// degree 10 with the roots 1 .. 10, whose coefficients reach 10^7
+	Polynomiald q = { 1.0 };
+	std::vector<std::complex<double>> expected;
+	for (int k = 1; k <= 10; ++k) {
+		q = q * Polynomiald({ 1.0, -double(k) });
+		expected.push_back(k);
+	}
+	std::vector<std::complex<double>> found(10);
+	EXPECT_EQ(roots(q, found.data(), &converged), 10);
+	EXPECT_TRUE(converged);
+	expectRoots(found.data(), 10, expected, 1e-6);
+
+	// leading zeros lower the degree, trailing ones give exact zero roots
+	double const coefficients[] = { 0.0, 1.0, 0.0, -4.0, 0.0 };
+	EXPECT_EQ(roots(coefficients, 4, res), 3);
+	expectRoots(res, 3, { 0.0, 2.0, -2.0 }, 1e-14);
+	EXPECT_EQ(res[0], std::complex<double>());
+
+	// a double root is found to about sqrt(eps)
+	auto const doubled = (X - 1.0) * (X - 1.0) * (X + 1.0);
+	EXPECT_EQ(roots(doubled, res, &converged), 3);
+	EXPECT_TRUE(converged);
+	expectRoots(res, 3, { 1.0, 1.0, -1.0 }, 1e-7);
+}
+
+TEST(RootsTest, RealRootsTest) {
+	Xd const X;
+	auto const p = (X - 0.5) * (X + 1.0) * (X - 2.0) * (X * X + 1.0);
+	double res[5];
+	ASSERT_EQ(realRoots(p, -2.0, 3.0, res), 3);
+	EXPECT_NEAR(res[0], -1.0, 1e-15);
+	EXPECT_NEAR(res[1], 0.5, 1e-15);
+	EXPECT_NEAR(res[2], 2.0, 1e-15);
+	ASSERT_EQ(realRoots(p, 0.0, 1.0, res), 1);
+	EXPECT_NEAR(res[0], 0.5, 1e-15);
+	EXPECT_EQ(realRoots(p, 2.5, 10.0, res), 0);
+	// the ends of the interval count
+	ASSERT_EQ(realRoots(p, -1.0, 0.5, res), 2);
+	EXPECT_EQ(res[0], -1.0);
+	EXPECT_EQ(res[1], 0.5);
+
+	// multiple roots once each, also without a sign change
+	auto const multiple = (X - 1.0) * (X - 1.0) * (X - 2.0) * (X - 2.0) * (X - 2.0);
+	// found to about eps^(1 / multiplicity), where p is lost in its rounding
+	ASSERT_EQ(realRoots(multiple, 0.0, 3.0, res), 2);
+	EXPECT_NEAR(res[0], 1.0, 1e-7);
+	EXPECT_NEAR(res[1], 2.0, 1e-4);
+
+	// runtime degree, close roots, which p' of about 1e-3 leaves with a thousandfold error
+	Polynomiald const close = Polynomiald({ 1.0, -1.0 }) * Polynomiald({ 1.0, -1.001 }) * Polynomiald({ 1.0, 0.999 });
+	ASSERT_EQ(realRoots(close, -5.0, 5.0, res), 3);
+	EXPECT_NEAR(res[0], -0.999, 1e-14);
+	EXPECT_NEAR(res[1], 1.0, 1e-12);
+	EXPECT_NEAR(res[2], 1.001, 1e-12);
+}
+
+TEST(RootsTest, RationalFunctionTest) {
+	Xd const X;
+	auto const f = (X * X - 1.0) / (X * X + 4.0);
+	std::complex<double> res[2];
+	EXPECT_EQ(zeros(f, res), 2);
+	expectRoots(res, 2, { 1.0, -1.0 }, 1e-14);
+	EXPECT_EQ(poles(f, res), 2);
+	expectRoots(res, 2, { { 0.0, 2.0 }, { 0.0, -2.0 } }, 1e-14);
+}
+
+TEST(RootsTest, BatchTest) {
+	// quartics with four real roots in [-1, 1], solved one by one and as a batch
+	int const count = 2000;
+	random::Generator generator(11);
+	std::vector<double> chosen(4 * count);
+	generator.uniform(chosen.data(), 4 * count, -1.0, 1.0);
+	Xd const X;
+	std::vector<PolynomicFunction<4, double>> quartics;
+	for (int i = 0; i < count; ++i) {
+		double const* r = chosen.data() + 4 * i;
+		quartics.push_back((X - r[0]) * (X - r[1]) * (X - r[2]) * (X - r[3]));
+	}
+
+	std::vector<double> real(4 * count);
+	std::vector<int> found(count);
+	std::vector<std::complex<double>> all(4 * count);
+	std::unique_ptr<bool[]> converged(new bool[count]);
+	parallel::setThreadCount(4);
+	realRoots(quartics.data(), count, -2.0, 2.0, real.data(), found.data());
+	roots(quartics.data(), count, all.data(), converged.get());
+	parallel::setThreadCount(0);
+
+	for (int i = 0; i < count; ++i) {
+		double single[4];
+		ASSERT_EQ(found[i], realRoots(quartics[i], -2.0, 2.0, single));
+		for (int k = 0; k < found[i]; ++k) EXPECT_EQ(real[4 * i + k], single[k]);
+		EXPECT_EQ(found[i], 4);
+		std::vector<double> sorted(chosen.begin() + 4 * i, chosen.begin() + 4 * i + 4);
+		std::sort(sorted.begin(), sorted.end());
+		// close roots are ill conditioned, the error is about the rounding of p over p'
+		for (int k = 0; k < found[i]; ++k) {
+			double derivative = 1.0;
+			for (int j = 0; j < 4; ++j) derivative *= j == k ? 1.0 : sorted[k] - sorted[j];
+			EXPECT_NEAR(real[4 * i + k], sorted[k], 1e-14 / std::abs(derivative));
+		}
+
+		std::complex<double> singleAll[4];
+		bool singleConverged;
+		roots(quartics[i], singleAll, &singleConverged);
+		EXPECT_EQ(converged[i], singleConverged);
+		for (int k = 0; k < 4; ++k) EXPECT_EQ(all[4 * i + k], singleAll[k]);
+	}
+
+	// a lower true degree leaves NaN slots
+	PolynomicFunction<4, double> const quadratic({ 0.0, 0.0, 1.0, 0.0, -1.0 });
+	std::complex<double> res[4];
+	roots(&quadratic, 1, res);
+	EXPECT_TRUE(std::isnan(res[2].real()) && std::isnan(res[3].real()));
+}
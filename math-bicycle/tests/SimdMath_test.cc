@@ -0,0 +1,87 @@
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <gtest/gtest.h>
+#include "../src/Dual.h"
+#include "../src/SimdMath.h"
+
+using namespace bm;
+
+// largest error in units of the last place of the std result
+template <typename T, typename Batch, typename Reference>
+double maxUlpError(std::vector<T> const& args, Batch const& batch, Reference const& reference) {
+	std::vector<T> res(args.size());
+	batch(args.data(), res.data(), static_cast<int>(args.size()));
+	double maxError = 0;
+	for (std::size_t i = 0; i < args.size(); ++i) {
+		T const expected = reference(args[i]);
+		if (std::isnan(expected)) {
+			EXPECT_TRUE(std::isnan(res[i])) << args[i];
+			continue;
+		}
+		if (std::isinf(expected) || expected == T(0)) {
+			EXPECT_EQ(res[i], expected) << args[i];
+			continue;
+		}
+		T const ulp = std::nextafter(std::fabs(expected), std::numeric_limits<T>::infinity()) - std::fabs(expected);
+		maxError = std::max(maxError, double(std::fabs(res[i] - expected) / ulp));
+	}
+	return maxError;
+}
+
+template <typename T>
+std::vector<T> range(T from, T to, int count) {
+	std::vector<T> res(count);
+	for (int i = 0; i < count; ++i) res[i] = from + (to - from) * T(i) / T(count - 1);
+	return res;
+}
+
+template <typename T>
+void checkKernels(double maxUlp) {
+	auto const trig = range<T>(T(-20), T(20), 100001);
+	EXPECT_LE(maxUlpError(trig, simd::sin<T>, [](T x) { return std::sin(x); }), maxUlp);
+	EXPECT_LE(maxUlpError(trig, simd::cos<T>, [](T x) { return std::cos(x); }), maxUlp);
+
+	auto const exps = range<T>(T(-700), T(700), 100001);
+	EXPECT_LE(maxUlpError(exps, simd::exp<T>, [](T x) { return std::exp(x); }), maxUlp);
+	EXPECT_LE(maxUlpError(range<T>(T(-1), T(1), 10001), simd::exp<T>, [](T x) { return std::exp(x); }), maxUlp);
+
+	std::vector<T> logs;
+	for (T x = std::numeric_limits<T>::min(); x < std::numeric_limits<T>::max() / 2; x *= T(1.37)) logs.push_back(x);
+	for (T const x : range<T>(T(0.5), T(2), 10001)) logs.push_back(x);
+	EXPECT_LE(maxUlpError(logs, simd::log<T>, [](T x) { return std::log(x); }), maxUlp);
+	EXPECT_LE(maxUlpError(logs, simd::log10<T>, [](T x) { return std::log10(x); }), maxUlp + 1);
+
+	// inputs outside the kernels go to std
+	T const inf = std::numeric_limits<T>::infinity(), nan = std::numeric_limits<T>::quiet_NaN();
+	std::vector<T> const special = { T(0), -T(0), T(-1), inf, -inf, nan, T(1e30), T(-1e30), std::numeric_limits<T>::denorm_min(), T(1) };
+	maxUlpError(special, simd::sin<T>, [](T x) { return std::sin(x); });
+	maxUlpError(special, simd::cos<T>, [](T x) { return std::cos(x); });
+	maxUlpError(special, simd::exp<T>, [](T x) { return std::exp(x); });
+	maxUlpError(special, simd::log<T>, [](T x) { return std::log(x); });
+}
+
+TEST(SimdMathTest, FloatTest) {
+	checkKernels<float>(2);
+}
+
+TEST(SimdMathTest, DoubleTest) {
+	checkKernels<double>(2);
+}
+
+TEST(SimdMathTest, InPlaceAndFallbackTest) {
+	auto args = range<double>(-3.0, 3.0, 1000);
+	std::vector<double> res(args.size());
+	simd::cosh(args.data(), res.data(), 1000);
+	simd::sin(args.data(), args.data(), 1000);
+	for (int i = 0; i < 1000; ++i) {
+		double const x = -3.0 + 6.0 * i / 999;
+		EXPECT_NEAR(args[i], std::sin(x), 1e-15);
+		EXPECT_NEAR(res[i], std::cosh(x), 1e-14);
+	}
+
+	Duald duals[3] = { Duald::variable(0.5), Duald::variable(1.0), Duald::variable(2.0) };
+	simd::exp(duals, duals, 3);
+	EXPECT_DOUBLE_EQ(duals[1].value, std::exp(1.0));
+	EXPECT_DOUBLE_EQ(duals[2].d[0], std::exp(2.0));
+}
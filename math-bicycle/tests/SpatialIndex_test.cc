@@ -0,0 +1,154 @@
+#include <algorithm>
+#include <random>
+#include <vector>
+#include <gtest/gtest.h>
+#include "../src/SpatialIndex.h"
+
+using namespace bm;
+
+namespace {
+
+	template <int Len>
+	std::vector<Point<Len, float>> randomPoints(int count, unsigned seed) {
+		std::mt19937 generator(seed);
+		std::uniform_real_distribution<float> distribution(-10.0f, 10.0f);
+		std::vector<Point<Len, float>> points;
+		points.reserve(count);
+		for (int i = 0; i < count; ++i) {
+			Point<Len, float> point;
+			for (int d = 0; d < Len; ++d) point[d] = distribution(generator);
+			points.push_back(point);
+		}
+		return points;
+	}
+
+	template <int Len>
+	float squaredDistance(Point<Len, float> const& a, Point<Len, float> const& b) {
+		float res = 0.0f;
+		for (int d = 0; d < Len; ++d) res += (a.at(d) - b.at(d)) * (a.at(d) - b.at(d));
+		return res;
+	}
+
+	// the spatial index against brute force over the same points
+	template <int Len, typename Index>
+	void checkQueries(Index const& index, std::vector<Point<Len, float>> const& points, std::vector<Point<Len, float>> const& queries) {
+		int const k = 5;
+		float const radius = 1.5f;
+		for (auto const& query : queries) {
+			std::vector<float> distances;
+			for (auto const& point : points) distances.push_back(squaredDistance(query, point));
+			std::vector<float> sorted = distances;
+			std::sort(sorted.begin(), sorted.end());
+
+			int indices[k];
+			float squaredDistances[k];
+			EXPECT_EQ(index.knn(query, k, indices, squaredDistances), std::min<int>(k, static_cast<int>(points.size())));
+			for (int i = 0; i < k && i < static_cast<int>(points.size()); ++i) {
+				EXPECT_EQ(squaredDistances[i], sorted[i]);
+				EXPECT_EQ(distances[indices[i]], squaredDistances[i]);
+			}
+
+			std::vector<int> found, expected;
+			index.radius(query, radius, found);
+			for (int i = 0; i < static_cast<int>(points.size()); ++i) {
+				if (distances[i] <= radius * radius) expected.push_back(i);
+			}
+			std::sort(found.begin(), found.end());
+			EXPECT_EQ(found, expected);
+
+			Point<Len, float> min(query), max(query);
+			for (int d = 0; d < Len; ++d) {
+				min[d] -= 1.0f + d;
+				max[d] += 2.0f;
+			}
+			found.clear();
+			expected.clear();
+			index.box(min, max, found);
+			for (int i = 0; i < static_cast<int>(points.size()); ++i) {
+				bool inside = true;
+				for (int d = 0; d < Len; ++d) inside = inside && points[i].at(d) >= min.at(d) && points[i].at(d) <= max.at(d);
+				if (inside) expected.push_back(i);
+			}
+			std::sort(found.begin(), found.end());
+			EXPECT_EQ(found, expected);
+		}
+	}
+
+	// batched queries against the single query versions
+	template <int Len, typename Index>
+	void checkBatches(Index const& index, std::vector<Point<Len, float>> const& queries) {
+		int const k = 3, count = static_cast<int>(queries.size());
+		std::vector<int> indices(count * k);
+		std::vector<float> squaredDistances(count * k);
+		index.knn(queries.data(), count, k, indices.data(), squaredDistances.data());
+
+		std::vector<int> offsets, found;
+		index.radius(queries.data(), count, 0.8f, offsets, found);
+		ASSERT_EQ(offsets.size(), queries.size() + 1);
+		ASSERT_EQ(offsets.back(), static_cast<int>(found.size()));
+
+		for (int i = 0; i < count; ++i) {
+			int single[k];
+			index.knn(queries[i], k, single);
+			EXPECT_TRUE(std::equal(single, single + k, indices.begin() + i * k));
+
+			std::vector<int> singleFound;
+			index.radius(queries[i], 0.8f, singleFound);
+			EXPECT_TRUE(std::equal(singleFound.begin(), singleFound.end(), found.begin() + offsets[i], found.begin() + offsets[i + 1]));
+		}
+	}
+
+}
+
+TEST(SpatialIndexTest, KdTreeQueryTest) {
+	auto const points = randomPoints<3>(2000, 1);
+	auto const queries = randomPoints<3>(50, 2);
+	KdTree3f const tree(points.data(), static_cast<int>(points.size()));
+	EXPECT_EQ(tree.size(), 2000);
+	checkQueries(tree, points, queries);
+	EXPECT_EQ(tree.nearest(points[123]), 123);
+
+	auto const points2d = randomPoints<2>(3, 3);
+	KdTree2f const small(points2d.data(), static_cast<int>(points2d.size()));
+	checkQueries(small, points2d, randomPoints<2>(10, 4));
+	int indices[5];
+	EXPECT_EQ(small.knn(points2d[0], 5, indices), 3);
+	EXPECT_EQ(indices[3], -1);
+
+	KdTree2f const empty(points2d.data(), 0);
+	EXPECT_EQ(empty.nearest(points2d[0]), -1);
+}
+
+TEST(SpatialIndexTest, UniformGridQueryTest) {
+	auto const points = randomPoints<3>(2000, 5);
+	// queries partly outside the occupied cells
+	auto queries = randomPoints<3>(50, 6);
+	for (auto& query : queries) query[0] *= 3.0f;
+	UniformGrid3f const grid(points.data(), static_cast<int>(points.size()), 1.0f);
+	checkQueries(grid, points, queries);
+	EXPECT_EQ(grid.nearest(points[77]), 77);
+
+	auto const points2d = randomPoints<2>(500, 7);
+	UniformGrid2f const coarse(points2d.data(), static_cast<int>(points2d.size()), 4.0f);
+	checkQueries(coarse, points2d, randomPoints<2>(50, 8));
+	UniformGrid2f const fine(points2d.data(), static_cast<int>(points2d.size()), 0.1f);
+	checkQueries(fine, points2d, randomPoints<2>(50, 9));
+}
+
+TEST(SpatialIndexTest, BatchedQueryTest) {
+	parallel::setThreadCount(4);
+	auto const points = randomPoints<2>(parallel::MinWorkPerThread * 2, 10);
+	auto const queries = randomPoints<2>(5000, 11);
+	KdTree2f const tree(points.data(), static_cast<int>(points.size()));
+	UniformGrid2f const grid(points.data(), static_cast<int>(points.size()), 0.5f);
+	checkBatches(tree, queries);
+	checkBatches(grid, queries);
+
+	// the parallel build gives the same tree as the sequential one
+	parallel::setThreadCount(1);
+	KdTree2f const sequential(points.data(), static_cast<int>(points.size()));
+	parallel::setThreadCount(0);
+	for (int i = 0; i < 100; ++i) {
+		EXPECT_EQ(tree.nearest(queries[i]), sequential.nearest(queries[i]));
+	}
+}
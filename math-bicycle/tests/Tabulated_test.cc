@@ -0,0 +1,90 @@
+#include <cmath>
+#include <vector>
+#include <gtest/gtest.h>
+#include "../src/Function.h"
+#include "../src/PolynomicFunction.h"
+#include "../src/Tabulated.h"
+
+using namespace bm;
+
+// largest difference from func over a grid denser than any table
+template <typename Table, typename Func>
+double maxError(Table const& table, Func const& func, double start, double end) {
+	double res = 0.0;
+	for (int i = 0; i <= 10000; ++i) {
+		double const x = start + (end - start) * i / 10000.0;
+		res = std::max(res, std::abs(table(x) - func(x)));
+	}
+	return res;
+}
+
+TEST(TabulatedTest, ToleranceTest) {
+	Xd const X;
+	auto const f = sin(X * 3.0) * exp(-X) + X * X / (cosh(X) + 1.0);
+	double const tolerance = 1e-6;
+
+	auto const linear = tabulate(f, 0.0, 3.0, tolerance, Interpolation::Linear);
+	auto const cubic = tabulate(f, 0.0, 3.0, tolerance, Interpolation::Cubic);
+	auto const chebyshev = tabulate(f, 0.0, 3.0, tolerance, Interpolation::Chebyshev);
+	for (auto const* table : { &linear, &cubic, &chebyshev }) {
+		EXPECT_TRUE(table->accurate());
+		EXPECT_LE(table->error(), tolerance);
+		// the estimate holds between the checked points too, up to a small factor
+		EXPECT_LE(maxError(*table, f, 0.0, 3.0), 2.0 * tolerance);
+	}
+	// higher orders need fewer nodes
+	EXPECT_LT(cubic.size(), linear.size());
+	EXPECT_LT(chebyshev.size(), cubic.size());
+	EXPECT_LE(chebyshev.size(), 65);
+
+	// a cubic is reproduced exactly by the first grid
+	double const coefficients[] = { 2.0, -3.0, 0.5, 7.0 };
+	PolynomicFunction<3, double> const poly(coefficients);
+	auto const exact = tabulate(poly, -1.0, 2.0, 1e-12);
+	EXPECT_EQ(exact.size(), 17);
+	EXPECT_LE(maxError(exact, poly, -1.0, 2.0), 1e-12);
+}
+
+TEST(TabulatedTest, LimitTest) {
+	// a kink off the grid keeps Chebyshev interpolation from converging
+	auto const kink = [](double x) { return std::abs(x - 0.3); };
+	auto const chebyshev = tabulate(kink, -1.0, 1.0, 1e-10, Interpolation::Chebyshev, 256);
+	EXPECT_FALSE(chebyshev.accurate());
+	EXPECT_GT(chebyshev.error(), 1e-10);
+	EXPECT_EQ(chebyshev.size(), 257);
+	EXPECT_LE(maxError(chebyshev, kink, -1.0, 1.0), 1e-2);
+
+	// NaN is never accurate
+	auto const undefined = tabulate([](double x) { return std::sqrt(x); }, -1.0, 1.0, 1e-3, Interpolation::Linear, 64);
+	EXPECT_FALSE(undefined.accurate());
+}
+
+TEST(TabulatedTest, EvaluateTest) {
+	auto const f = [](float x) { return std::exp(-x * x); };
+	Interpolation const kinds[] = { Interpolation::Linear, Interpolation::Cubic, Interpolation::Chebyshev };
+	for (Interpolation const kind : kinds) {
+		auto const table = tabulate(f, -2.f, 2.f, 1e-4f, kind);
+		EXPECT_TRUE(table.accurate());
+		EXPECT_EQ(table.start(), -2.f);
+		EXPECT_EQ(table.end(), 2.f);
+
+		std::vector<float> args(1000), res(1000);
+		for (int i = 0; i < 1000; ++i) args[i] = -2.5f + 5.f * i / 999.f;
+		table.evaluate(args.data(), res.data(), 1000);
+		for (int i = 0; i < 1000; ++i) {
+			EXPECT_EQ(res[i], table(args[i]));
+			if (std::abs(args[i]) <= 2.f) {
+				EXPECT_NEAR(res[i], f(args[i]), 2e-4f);
+			}
+		}
+		// in place
+		table.evaluate(args.data(), args.data(), 1000);
+		EXPECT_EQ(args, res);
+		// the ends are nodes, met exactly by the piecewise interpolants
+		if (kind != Interpolation::Chebyshev) {
+			EXPECT_EQ(table(2.f), f(2.f));
+			EXPECT_EQ(table(-2.f), f(-2.f));
+		}
+		else EXPECT_NEAR(table(2.f), f(2.f), 1e-6f);
+	}
+}
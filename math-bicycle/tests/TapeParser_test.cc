@@ -0,0 +1,79 @@
+#include <cmath>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include "../src/Function.h"
+#include "../src/PolynomicFunction.h"
+#include "../src/Tape.h"
+#include "../src/TapeParser.h"
+
+using namespace bm;
+
+TEST(TapeParserTest, ParseTest) {
+	Tape<double> tape;
+	ASSERT_TRUE(parse("sin(x)*exp(-x)+3*x^2", tape));
+	Xd const X;
+	auto const f = sin(X) * exp(-X) + 3.0 * pow<2>(X);
+
+	int const count = 1000;
+	std::vector<double> args(count), res(count);
+	for (int i = 0; i < count; ++i) args[i] = -4.0 + i * 0.008;
+	tape.evaluate(args.data(), res.data(), count);
+	for (int i = 0; i < count; ++i) EXPECT_NEAR(res[i], f(args[i]), 1e-13 * (1.0 + std::fabs(res[i])));
+
+	// precedence, associativity, constants and spaces
+	ASSERT_TRUE(parse(" 2 - x - 1 / 4 / x ^ 2 ^ 1 * -x + 2^-1 + pi * e - log10(100) ", tape));
+	EXPECT_NEAR(tape(2.0), 2.0 - 2.0 - 0.25 / 4.0 * -2.0 + 0.5 + M_PI * M_E - 2.0, 1e-14);
+	ASSERT_TRUE(parse("-x^2 + sqrt(x)^3 + x^0.5 + abs(tanh(x) - atan(x)) * cosh(x) / sinh(x) + tan(x) / cos(x) + log(X)", tape));
+	double const x = 0.7;
+	EXPECT_NEAR(tape(x), -x * x + std::pow(std::sqrt(x), 3) + std::sqrt(x) + std::abs(std::tanh(x) - std::atan(x)) * std::cosh(x) / std::sinh(x)
+		+ std::tan(x) / std::cos(x) + std::log(x), 1e-14);
+
+	// the text is folded and merged like a compiled expression
+	ASSERT_TRUE(parse("sin(x)*sin(x) + cos(x)*sin(x) + 2*3", tape));
+	EXPECT_EQ(tape.operations(), 6);
+}
+
+TEST(TapeParserTest, ErrorTest) {
+	Tape<float> tape;
+	ASSERT_TRUE(parse("x+1", tape));
+	std::string error;
+	char const* const wrong[] = { "", "x+", "sin x", "(x+1", "x+1)", "foo(x)", "3x", "x*/2", "sin(x" };
+	for (char const* text : wrong) {
+		EXPECT_FALSE(parse(text, tape, &error)) << text;
+		EXPECT_FALSE(error.empty());
+	}
+	EXPECT_FALSE(parse("2*y", tape, &error));
+	EXPECT_EQ(error, "unknown name y at 2");
+	// the tape is left as it was
+	EXPECT_EQ(tape(1.0f), 2.0f);
+}
+
+TEST(TapeParserTest, RoundTripTest) {
+	char const* const texts[] = {
+		"sin(x)*exp(-x)+3*x^2",
+		"x-(x-1)-x/(x/2)",
+		"-(x+1)*-x^3-(-x)^2",
+		"(x*x)^-2+0.1*x",
+		"exp(sin(x)^2/(1+x^2))-log(abs(x)+1e-3)",
+	};
+	for (char const* text : texts) {
+		Tape<double> tape, again;
+		ASSERT_TRUE(parse(text, tape)) << text;
+		std::string const str = tape.toString();
+		ASSERT_TRUE(parse(str, again)) << str;
+		EXPECT_EQ(again.toString(), str) << text;
+		for (double arg = -2.1; arg < 2.0; arg += 0.3) EXPECT_EQ(again(arg), tape(arg)) << str;
+	}
+
+	// compiled expressions print polynomials in Horner form
+	Xd const X;
+	auto const f = sin(X * X * 2.0 - X + 0.5) / (X * X * X + 1.0) - cos(X) * 1.25;
+	Tape<double> const compiled = compile(f);
+	Tape<double> reparsed;
+	ASSERT_TRUE(parse(compiled.toString(), reparsed)) << compiled.toString();
+	for (double arg = -0.9; arg < 2.0; arg += 0.1) EXPECT_NEAR(reparsed(arg), f(arg), 1e-14) << compiled.toString();
+	EXPECT_EQ(compile(X * X * 2.0 - X + 0.5).toString(), "(2*x-1)*x+0.5");
+	EXPECT_EQ(compile(sin(X) * 1.25).toString(), "sin(x)*1.25");
+	EXPECT_EQ(Tape<float>().toString(), "x");
+}
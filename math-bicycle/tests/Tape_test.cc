@@ -0,0 +1,70 @@
+#include <cmath>
+#include <vector>
+#include <gtest/gtest.h>
+#include "../src/Dual.h"
+#include "../src/Function.h"
+#include "../src/PolynomicFunction.h"
+#include "../src/Tape.h"
+
+using namespace bm;
+
+TEST(TapeTest, CommonSubexpressionTest) {
+	Xd const X;
+	auto const f = sin(X) * sin(X) + cos(X) * sin(X);
+	Tape<double> const tape = compile(f);
+	// sin, cos, two products and the sum
+	EXPECT_EQ(tape.operations(), 5);
+
+	// equal polynomials are one instruction, operands of + and * in any order too
+	auto const g = exp(X * X + 1.0) / (sin(X * X + 1.0) * X + X * sin(X * X + 1.0)) - pow<2>(X * X + 1.0);
+	Tape<double> const gTape = compile(g);
+	// X^2+1, exp, sin, sin * X, the sum, the quotient, (X^2+1)^2 folded into a polynomial, the difference
+	EXPECT_EQ(gTape.operations(), 8);
+
+	int const count = 1000;
+	std::vector<double> args(count), res(count);
+	for (int i = 0; i < count; ++i) args[i] = -3.0 + i * 0.0061;
+	gTape.evaluate(args.data(), res.data(), count);
+	for (int i = 0; i < count; ++i) {
+		EXPECT_NEAR(res[i], g(args[i]), 1e-13 * (1.0 + std::fabs(res[i])));
+		EXPECT_EQ(gTape(args[i]), res[i]);
+	}
+
+	// in place gives the same values
+	gTape.evaluate(args.data(), args.data(), count);
+	EXPECT_EQ(args, res);
+}
+
+TEST(TapeTest, ConstantFoldingTest) {
+	Xd const X;
+	// everything but the last sum is known when the tape is built
+	auto const f = sin(Oned() * 2.0) * exp(-Oned()) + pow<3>(Oned() + 1.0) * 0.25 + X;
+	Tape<double> const tape = compile(f);
+	EXPECT_EQ(tape.operations(), 1);
+	EXPECT_EQ(tape.size(), 3);
+	EXPECT_NEAR(tape(0.5), std::sin(2.0) * std::exp(-1.0) + 2.0 + 0.5, 1e-15);
+
+	Tape<double> const constant = compile(cos(Oned() - 1.0) * 3.0);
+	EXPECT_EQ(constant.operations(), 0);
+	EXPECT_EQ(constant(7.0), 3.0);
+	EXPECT_EQ(compile(X)(7.0), 7.0);
+}
+
+TEST(TapeTest, RegisterTest) {
+	Xf const X;
+	// a long chain needs no more than a few registers
+	auto const f = sin(cos(exp(sin(cos(X * 0.5f) + 1.0f) * 0.25f) - 0.5f) * 2.0f) + tanh(X) - pow<-2>(X + 3.0f);
+	Tape<float> const tape = compile(f);
+	int const count = 2 * EvaluationBlock + 17;
+	std::vector<float> args(count), res(count);
+	for (int i = 0; i < count; ++i) args[i] = -2.0f + i * 0.01f;
+	tape.evaluate(args.data(), res.data(), count);
+	for (int i = 0; i < count; ++i) EXPECT_NEAR(res[i], f(args[i]), 1e-5f * (1.0f + std::fabs(res[i])));
+
+	// derivatives compile as well, on any element type
+	X_<Duald> const dualX;
+	auto const g = sin(dualX) * exp(dualX);
+	Tape<Duald> const dg = compile(g);
+	Duald const value = dg(Duald::variable(0.7));
+	EXPECT_NEAR(value.d[0], compile(g.derivative())(Duald(0.7)).value, 1e-14);
+}
@@ -1,4 +1,8 @@
+#include <algorithm>
+#include <vector>
 #include <gtest/gtest.h>
+#include "../src/Color.h"
+#include "../src/Point.h"
 #include "../src/Vector.h"
 
 using namespace bm;
@@ -129,4 +133,59 @@ TEST(VectorTest, CrossProductTest) {
 	};
 
 	EXPECT_TRUE(equals(vec3f1.cross(vec3f2), get_cross(init_array1, init_array2), precission));
-}
\ No newline at end of file
+}
+
+TEST(VectorTest, NormOverflowTest) {
+	Vector2f huge(3e30f, 4e30f), tiny(3e-30f, 4e-30f);
+
+	EXPECT_NEAR(huge.norm() / 5e30f, 1.0f, precission);
+	EXPECT_NEAR(tiny.norm() / 5e-30f, 1.0f, precission);
+	EXPECT_NEAR(huge.norm<Reduction::Compensated>() / 5e30f, 1.0f, precission);
+	EXPECT_EQ(Vector2f().norm(), 0.0f);
+}
+
+TEST(VectorTest, TypeConversionTest) {
+	Vector3f vec3f(1.7f, -2.2f, 300.5f);
+	Vector3i vec3i(3, 4, 5);
+
+	EXPECT_EQ(changeT<int>(vec3f), Vector3i(1, -2, 300));
+	EXPECT_EQ(Vector3d(vec3f), Vector3d(1.7f, -2.2f, 300.5f));
+	EXPECT_TRUE(equals(vec3f + vec3i, Vector3f(4.7f, 1.8f, 305.5f), precission));
+	EXPECT_TRUE(equals(vec3i * vec3f, Vector3f(5.1f, -8.8f, 1502.5f), precission));
+
+	Point2i point2i(1, 2);
+	Point2f point2f(0.5f, 0.5f);
+	EXPECT_TRUE(equals(point2i - point2f, Vector2f(0.5f, 1.5f), precission));
+	EXPECT_TRUE(equals(point2i + Vector2f(0.5f, 0.5f), Point2f(1.5f, 2.5f), precission));
+	EXPECT_EQ(Point2d(point2i), Point2d(1.0, 2.0));
+
+	Vector3f colorsf[] = { Vector3f(0.0f, 127.9f, 255.0f), Vector3f(-20.0f, 300.0f, 64.0f) };
+	ColorRGB colors[2];
+	changeT(colorsf, colors, 2);
+	EXPECT_EQ(colors[0], ColorRGB(0, 127, 255));
+	EXPECT_EQ(colors[1], ColorRGB(0, 255, 64));
+	EXPECT_EQ(changeT<unsigned char>(colorsf[1]), colors[1]);
+
+	// more vectors than one conversion block
+	std::vector<Vector3f> manyf;
+	for (int i = 0; i < 1000; ++i) manyf.emplace_back(float(i) - 300.0f, float(i), 0.5f * float(i));
+	std::vector<ColorRGB> many(manyf.size());
+	changeT(manyf.data(), many.data(), static_cast<int>(manyf.size()));
+	for (std::size_t i = 0; i < manyf.size(); ++i) EXPECT_EQ(many[i], changeT<unsigned char>(manyf[i]));
+	EXPECT_EQ(many[999], ColorRGB(255, 255, 255));
+	EXPECT_EQ(many[100], ColorRGB(0, 100, 50));
+
+	// vectors longer than a block
+	std::vector<Vector<2000, float>> longf(2);
+	for (int i = 0; i < 2000; ++i) {
+		longf[0][i] = float(i) - 1000.0f;
+		longf[1][i] = float(i) * 0.1f;
+	}
+	std::vector<Vector<2000, unsigned char>> longc(2);
+	changeT(longf.data(), longc.data(), 2);
+	Vector<2000, unsigned char> const single = changeT<unsigned char>(longf[1]);
+	for (int i = 0; i < 2000; ++i) {
+		EXPECT_EQ(longc[0].at(i), static_cast<unsigned char>(std::min(std::max(i - 1000, 0), 255)));
+		EXPECT_EQ(longc[1].at(i), single.at(i));
+	}
+}